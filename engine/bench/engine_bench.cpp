@@ -0,0 +1,1161 @@
+// Engine microbenchmarks for the software rasterization hot paths
+//
+// Runs without a window: everything renders into IndexedPixelBuffers in RAM.
+// Reports ns/op, pixels/s and heap allocations per op so engine changes can be
+// compared run-to-run.
+//
+// Usage: engine_bench [--filter <substring>] [--min-time <seconds>] [--json <file>]
+
+#include "engine/IndexedPixelBuffer.h"
+#include "engine/AllocationTracker.h"
+#include "engine/BlendTable.h"
+#include "engine/HeadlessRenderer.h"
+#include "engine/PixelKernels.h"
+#include "engine/AttributedTextGrid.h"
+#include "engine/Mesh3D.h"
+#include "engine/PixelFont.h"
+#include "engine/PixelBuffer.h"
+#include "engine/ShadeTable.h"
+#include "engine/WorkerPool.h"
+#include <SDL.h>
+#include <atomic>
+#include <chrono>
+#include <climits>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <functional>
+#include <iostream>
+#include <new>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace Engine;
+
+// ---------------------------------------------------------------------------
+// Allocation counting (global operator new/delete replacement for this binary)
+// ---------------------------------------------------------------------------
+
+#if ENGINE_ALLOC_TRACKING
+
+// The engine library already replaces operator new; read its live counters
+namespace {
+uint64_t allocCount() { return AllocationTracker::getInstance().getCurrentFrame().allocations; }
+uint64_t allocBytes() { return AllocationTracker::getInstance().getCurrentFrame().bytes; }
+}
+
+#else
+
+namespace {
+std::atomic<uint64_t> gAllocCount{0};
+std::atomic<uint64_t> gAllocBytes{0};
+
+uint64_t allocCount() { return gAllocCount.load(std::memory_order_relaxed); }
+uint64_t allocBytes() { return gAllocBytes.load(std::memory_order_relaxed); }
+}
+
+void* operator new(std::size_t size) {
+    gAllocCount.fetch_add(1, std::memory_order_relaxed);
+    gAllocBytes.fetch_add(size, std::memory_order_relaxed);
+    if (void* p = std::malloc(size ? size : 1)) {
+        return p;
+    }
+    throw std::bad_alloc();
+}
+
+void* operator new[](std::size_t size) {
+    return operator new(size);
+}
+
+void operator delete(void* p) noexcept { std::free(p); }
+void operator delete[](void* p) noexcept { std::free(p); }
+void operator delete(void* p, std::size_t) noexcept { std::free(p); }
+void operator delete[](void* p, std::size_t) noexcept { std::free(p); }
+
+#endif // ENGINE_ALLOC_TRACKING
+
+namespace {
+
+// ---------------------------------------------------------------------------
+// Minimal benchmark harness
+// ---------------------------------------------------------------------------
+
+struct BenchCase {
+    std::string name;
+    int64_t pixelsPerOp = 0;           // Pixels touched per op (for throughput)
+    std::function<void()> op;          // One unit of work
+};
+
+struct BenchResult {
+    std::string name;
+    uint64_t iterations = 0;
+    double nsPerOp = 0.0;
+    double pixelsPerSecond = 0.0;
+    double allocsPerOp = 0.0;
+    double allocBytesPerOp = 0.0;
+};
+
+BenchResult runCase(const BenchCase& bench, double minTimeSeconds) {
+    using Clock = std::chrono::steady_clock;
+
+    // Warm-up (first-touch allocations, caches)
+    bench.op();
+
+    uint64_t iterations = 1;
+    for (;;) {
+        uint64_t allocsBefore = allocCount();
+        uint64_t bytesBefore = allocBytes();
+        auto start = Clock::now();
+        for (uint64_t i = 0; i < iterations; ++i) {
+            bench.op();
+        }
+        auto end = Clock::now();
+        uint64_t allocs = allocCount() - allocsBefore;
+        uint64_t bytes = allocBytes() - bytesBefore;
+
+        double seconds = std::chrono::duration<double>(end - start).count();
+        if (seconds >= minTimeSeconds || iterations >= (1ull << 30)) {
+            BenchResult result;
+            result.name = bench.name;
+            result.iterations = iterations;
+            result.nsPerOp = seconds * 1e9 / iterations;
+            result.pixelsPerSecond = bench.pixelsPerOp > 0 ? bench.pixelsPerOp * iterations / seconds : 0.0;
+            result.allocsPerOp = static_cast<double>(allocs) / iterations;
+            result.allocBytesPerOp = static_cast<double>(bytes) / iterations;
+            return result;
+        }
+
+        // Grow towards the target time (at least double, at most 10x per round)
+        double scale = seconds > 0.0 ? (minTimeSeconds * 1.2) / seconds : 10.0;
+        scale = std::min(std::max(scale, 2.0), 10.0);
+        iterations = static_cast<uint64_t>(iterations * scale);
+    }
+}
+
+std::string tempPath(const std::string& fileName) {
+    return (std::filesystem::temp_directory_path() / fileName).string();
+}
+
+// ---------------------------------------------------------------------------
+// Fixtures
+// ---------------------------------------------------------------------------
+
+// Write a deterministic 8x8 1-bit font (0/1 bytes per pixel, sequential ASCII 0..255)
+PixelFontPtr createBenchFont() {
+    const int charWidth = 8;
+    const int charHeight = 8;
+    std::string path = tempPath("engine_bench_font.bin");
+
+    std::vector<uint8_t> data(256 * charWidth * charHeight);
+    std::mt19937 rng(1234);
+    for (auto& px : data) {
+        px = (rng() & 3) == 0 ? 0 : 1;  // ~25% dark pixels (dark = glyph)
+    }
+
+    std::ofstream out(path, std::ios::binary);
+    out.write(reinterpret_cast<const char*>(data.data()), static_cast<std::streamsize>(data.size()));
+    out.close();
+
+    auto font = std::make_shared<PixelFont>();
+    if (!font->loadFromBinary(path, charWidth, charHeight, "", 0)) {
+        return nullptr;
+    }
+    std::filesystem::remove(path);
+    return font;
+}
+
+// Write a deterministic RGB test image (gradients + noise) as BMP
+bool createBenchImage(const std::string& path, int width, int height) {
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormat(0, width, height, 32, SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        return false;
+    }
+
+    std::mt19937 rng(static_cast<uint32_t>(width * 31 + height));
+    SDL_LockSurface(surface);
+    for (int y = 0; y < height; ++y) {
+        uint8_t* row = static_cast<uint8_t*>(surface->pixels) + y * surface->pitch;
+        for (int x = 0; x < width; ++x) {
+            uint8_t noise = static_cast<uint8_t>(rng() & 31);
+            row[x * 4 + 0] = static_cast<uint8_t>((x * 255) / width) ^ noise;
+            row[x * 4 + 1] = static_cast<uint8_t>((y * 255) / height);
+            row[x * 4 + 2] = static_cast<uint8_t>(((x + y) * 127) / (width + height)) + noise;
+            row[x * 4 + 3] = 255;
+        }
+    }
+    SDL_UnlockSurface(surface);
+
+    bool ok = SDL_SaveBMP(surface, path.c_str()) == 0;
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+// ---------------------------------------------------------------------------
+// Benchmark registration
+// ---------------------------------------------------------------------------
+
+void addFillTriangleBenchmarks(std::vector<BenchCase>& cases) {
+    const int sizes[][2] = {{320, 200}, {640, 480}, {1280, 720}};
+    const int triangleCounts[] = {16, 256, 4096};
+
+    for (const auto& size : sizes) {
+        for (int count : triangleCounts) {
+            int width = size[0];
+            int height = size[1];
+            auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+
+            // Pre-generate triangles so the op only measures rasterization
+            // Triangles are sized relative to the buffer, partially off-screen
+            auto tris = std::make_shared<std::vector<int>>();
+            std::mt19937 rng(static_cast<uint32_t>(width * count));
+            std::uniform_int_distribution<int> xDist(-width / 8, width + width / 8);
+            std::uniform_int_distribution<int> yDist(-height / 8, height + height / 8);
+            std::uniform_int_distribution<int> rDist(4, std::max(8, width / 10));
+            double area = 0.0;
+            for (int i = 0; i < count; ++i) {
+                int cx = xDist(rng);
+                int cy = yDist(rng);
+                int r = rDist(rng);
+                int v[6] = {cx + static_cast<int>(rng() % r), cy - r,
+                            cx - r, cy + static_cast<int>(rng() % r),
+                            cx + r, cy + r};
+                tris->insert(tris->end(), v, v + 6);
+                area += std::abs((v[2] - v[0]) * (v[5] - v[1]) - (v[4] - v[0]) * (v[3] - v[1])) * 0.5;
+            }
+
+            BenchCase bench;
+            bench.name = "fillTriangle/" + std::to_string(width) + "x" + std::to_string(height) +
+                         "/tris:" + std::to_string(count);
+            bench.pixelsPerOp = static_cast<int64_t>(area);
+            bench.op = [buffer, tris]() {
+                const int* v = tris->data();
+                size_t n = tris->size();
+                for (size_t i = 0; i < n; i += 6) {
+                    buffer->fillTriangle(v[i], v[i + 1], v[i + 2], v[i + 3], v[i + 4], v[i + 5],
+                                         static_cast<uint8_t>(i));
+                }
+            };
+            cases.push_back(std::move(bench));
+        }
+    }
+}
+
+void addFillPolygonBenchmarks(std::vector<BenchCase>& cases) {
+    const int width = 640;
+    const int height = 480;
+    auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+
+    // Regular n-gons (step 1) and star polygons (step 2 winds twice around the
+    // center, so the rules disagree there), partially off-screen
+    struct Shape { const char* name; int vertices; int step; int count; };
+    const Shape shapes[] = {{"quads", 4, 1, 1024}, {"hexagons", 6, 1, 256}, {"stars", 5, 2, 256}};
+
+    for (const Shape& shape : shapes) {
+        auto points = std::make_shared<std::vector<Vec2>>();
+        std::mt19937 rng(static_cast<uint32_t>(shape.vertices * shape.count));
+        std::uniform_real_distribution<float> xDist(-width / 8.0f, width * 9.0f / 8.0f);
+        std::uniform_real_distribution<float> yDist(-height / 8.0f, height * 9.0f / 8.0f);
+        std::uniform_real_distribution<float> rDist(4.0f, width / 10.0f);
+        std::uniform_real_distribution<float> angleDist(0.0f, 6.2831853f);
+        double area = 0.0;
+        for (int i = 0; i < shape.count; ++i) {
+            float cx = xDist(rng);
+            float cy = yDist(rng);
+            float r = rDist(rng);
+            float angle = angleDist(rng);
+            for (int v = 0; v < shape.vertices; ++v) {
+                float a = angle + 6.2831853f * static_cast<float>(v * shape.step) / static_cast<float>(shape.vertices);
+                points->push_back(Vec2{cx + r * std::cos(a), cy + r * std::sin(a)});
+            }
+            area += 0.5 * shape.vertices * r * r * std::sin(6.2831853 / shape.vertices);
+        }
+        std::string prefix = std::string("fillPolygon/640x480/") + shape.name + ":" + std::to_string(shape.count);
+        int vertices = shape.vertices;
+
+        if (shape.step == 1) {
+            // Reference: the fan triangulation fillPolygon replaces in Mesh3D
+            BenchCase fan;
+            fan.name = prefix + "/fan";
+            fan.pixelsPerOp = static_cast<int64_t>(area);
+            fan.op = [buffer, points, vertices]() {
+                const Vec2* p = points->data();
+                for (size_t i = 0; i < points->size(); i += vertices) {
+                    for (int v = 1; v + 1 < vertices; ++v) {
+                        buffer->fillTriangle(p[i], p[i + v], p[i + v + 1], static_cast<uint8_t>(i));
+                    }
+                }
+            };
+            cases.push_back(std::move(fan));
+        }
+
+        for (FillRule rule : {FillRule::NonZero, FillRule::EvenOdd}) {
+            if (shape.step == 1 && rule == FillRule::EvenOdd) {
+                continue;  // Same pixels as non-zero for simple polygons
+            }
+            BenchCase bench;
+            bench.name = prefix + (rule == FillRule::NonZero ? "/nonzero" : "/evenodd");
+            bench.pixelsPerOp = shape.step == 1 ? static_cast<int64_t>(area) : 0;
+            bench.op = [buffer, points, vertices, rule]() {
+                const Vec2* p = points->data();
+                for (size_t i = 0; i < points->size(); i += vertices) {
+                    buffer->fillPolygon(p + i, vertices, static_cast<uint8_t>(i), rule);
+                }
+            };
+            cases.push_back(std::move(bench));
+        }
+    }
+}
+
+void addDrawLineBenchmarks(std::vector<BenchCase>& cases) {
+    const int width = 640;
+    const int height = 480;
+    const int lineCount = 1024;
+    // Endpoint spread relative to the buffer: 1 keeps lines on screen, 8 leaves
+    // most of each line off-buffer (the clipped part should cost nothing)
+    const int spreads[] = {1, 8};
+
+    for (int spread : spreads) {
+        auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+        auto lines = std::make_shared<std::vector<int>>();
+        std::mt19937 rng(static_cast<uint32_t>(spread));
+        std::uniform_int_distribution<int> xDist(-width * (spread - 1) / 2, width + width * (spread - 1) / 2);
+        std::uniform_int_distribution<int> yDist(-height * (spread - 1) / 2, height + height * (spread - 1) / 2);
+        int64_t steps = 0;
+        for (int i = 0; i < lineCount; ++i) {
+            int v[4] = {xDist(rng), yDist(rng), xDist(rng), yDist(rng)};
+            lines->insert(lines->end(), v, v + 4);
+            steps += std::max(std::abs(v[2] - v[0]), std::abs(v[3] - v[1])) + 1;
+        }
+
+        // pixelsPerOp counts full (unclipped) line length
+        BenchCase bench;
+        bench.name = "drawLine/" + std::to_string(width) + "x" + std::to_string(height) +
+                     "/spread:" + std::to_string(spread);
+        bench.pixelsPerOp = steps;
+        bench.op = [buffer, lines]() {
+            const int* v = lines->data();
+            size_t n = lines->size();
+            for (size_t i = 0; i < n; i += 4) {
+                buffer->drawLine(v[i], v[i + 1], v[i + 2], v[i + 3], static_cast<uint8_t>(i));
+            }
+        };
+        cases.push_back(std::move(bench));
+    }
+}
+
+void addBlitBenchmarks(std::vector<BenchCase>& cases) {
+    const int width = 640;
+    const int height = 480;
+    const int spriteSizes[] = {16, 32};
+    const int spriteCount = 512;
+
+    for (int size : spriteSizes) {
+        // Round-ish sprite: index 0 outside the circle is transparent
+        auto sprite = std::make_shared<IndexedPixelBuffer>(size, size);
+        for (int y = 0; y < size; ++y) {
+            for (int x = 0; x < size; ++x) {
+                int dx = 2 * x + 1 - size;
+                int dy = 2 * y + 1 - size;
+                bool inside = dx * dx + dy * dy <= size * size;
+                sprite->setPixel(x, y, inside ? static_cast<uint8_t>(1 + (x ^ y) % 15) : 0);
+            }
+        }
+
+        // Positions partially off-screen so clipping is exercised
+        auto positions = std::make_shared<std::vector<int>>();
+        std::mt19937 rng(static_cast<uint32_t>(size));
+        std::uniform_int_distribution<int> xDist(-size / 2, width - size / 2);
+        std::uniform_int_distribution<int> yDist(-size / 2, height - size / 2);
+        for (int i = 0; i < spriteCount; ++i) {
+            positions->push_back(xDist(rng));
+            positions->push_back(yDist(rng));
+        }
+
+        auto remap = std::make_shared<std::array<uint8_t, 256>>();
+        for (int i = 0; i < 256; ++i) {
+            (*remap)[i] = static_cast<uint8_t>((i + 16) & 0xFF);
+        }
+
+        struct Variant {
+            const char* name;
+            BlitOptions options;
+        };
+        BlendTablePtr blend = BlendTable::create(Palette::createGrayscale(), BlendMode::Alpha, 128);
+        Variant variants[] = {
+            {"opaque", BlitOptions()},
+            {"colorkey", BlitOptions()},
+            {"colorkey+flipX", BlitOptions()},
+            {"colorkey+remap", BlitOptions()},
+            {"colorkey+blend", BlitOptions()},
+        };
+        for (int i = 1; i < 5; ++i) {
+            variants[i].options.transparentIndex = 0;
+        }
+        variants[2].options.flipX = true;
+        variants[3].options.remap = remap->data();
+        variants[4].options.blend = blend.get();
+
+        std::string prefix = "blit/" + std::to_string(width) + "x" + std::to_string(height) +
+                             "/sprite:" + std::to_string(size) + "/";
+        auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+
+        for (const Variant& variant : variants) {
+            BenchCase bench;
+            bench.name = prefix + variant.name;
+            bench.pixelsPerOp = static_cast<int64_t>(spriteCount) * size * size;
+            BlitOptions options = variant.options;
+            bench.op = [buffer, sprite, positions, remap, blend, options]() {
+                const int* p = positions->data();
+                for (size_t i = 0; i < positions->size(); i += 2) {
+                    buffer->blit(*sprite, p[i], p[i + 1], options);
+                }
+            };
+            cases.push_back(std::move(bench));
+        }
+
+        // Reference: what callers did before blit() existed
+        BenchCase perPixel;
+        perPixel.name = prefix + "colorkey/getPixel+setPixel";
+        perPixel.pixelsPerOp = static_cast<int64_t>(spriteCount) * size * size;
+        perPixel.op = [buffer, sprite, positions, size]() {
+            const int* p = positions->data();
+            for (size_t i = 0; i < positions->size(); i += 2) {
+                for (int y = 0; y < size; ++y) {
+                    for (int x = 0; x < size; ++x) {
+                        uint8_t index = sprite->getPixel(x, y);
+                        if (index != 0) {
+                            buffer->setPixel(p[i] + x, p[i + 1] + y, index);
+                        }
+                    }
+                }
+            }
+        };
+        cases.push_back(std::move(perPixel));
+    }
+}
+
+void addBlendBenchmarks(std::vector<BenchCase>& cases) {
+    const int width = 320;
+    const int height = 200;
+    auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+    buffer->setPalette(Palette::createVGA().getColors());
+    BlendTablePtr blend = buffer->getBlendTable(BlendMode::Alpha, 128);
+
+    BenchCase create;
+    create.name = "BlendTable::create/alpha";
+    create.op = [buffer]() {
+        BlendTable::create(Palette::createVGA(), BlendMode::Alpha, 128);
+    };
+    cases.push_back(std::move(create));
+
+    for (bool translucent : {false, true}) {
+        const char* suffix = translucent ? "/blend" : "/opaque";
+
+        BenchCase rect;
+        rect.name = std::string("fillRect/320x200") + suffix;
+        rect.pixelsPerOp = static_cast<int64_t>(width) * height;
+        rect.op = [buffer, blend, translucent]() {
+            if (translucent) {
+                buffer->fillRect(0, 0, width, height, 40, *blend);
+            } else {
+                buffer->fillRect(0, 0, width, height, 40);
+            }
+        };
+        cases.push_back(std::move(rect));
+
+        BenchCase triangle;
+        triangle.name = std::string("fillTriangle/320x200/half") + suffix;
+        triangle.pixelsPerOp = static_cast<int64_t>(width) * height / 2;
+        triangle.op = [buffer, blend, translucent]() {
+            if (translucent) {
+                buffer->fillTriangle(0, 0, width - 1, 0, 0, height - 1, 40, *blend);
+            } else {
+                buffer->fillTriangle(0, 0, width - 1, 0, 0, height - 1, 40);
+            }
+        };
+        cases.push_back(std::move(triangle));
+    }
+}
+
+void addLightingBenchmarks(std::vector<BenchCase>& cases) {
+    BenchCase create;
+    create.name = "ShadeTable::create/32";
+    create.op = []() {
+        ShadeTable::create(Palette::createVGA(), 32);
+    };
+    cases.push_back(std::move(create));
+
+    struct Size { int width, height; };
+    const Size sizes[] = {{320, 200}, {1920, 1080}};
+    for (const Size& size : sizes) {
+        Palette palette = Palette::createVGA();
+        ShadeTablePtr shades = ShadeTable::create(palette, 32);
+        auto buffer = std::make_shared<IndexedPixelBuffer>(size.width, size.height);
+        buffer->setPalette(palette.getColors());
+        auto pixels = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(size.width) * size.height, 40);
+
+        // Radial falloff around the center of the screen
+        auto light = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(size.width) * size.height);
+        float radius = std::sqrt(static_cast<float>(size.width * size.width + size.height * size.height)) * 0.5f;
+        for (int y = 0; y < size.height; ++y) {
+            for (int x = 0; x < size.width; ++x) {
+                float dx = static_cast<float>(x - size.width / 2);
+                float dy = static_cast<float>(y - size.height / 2);
+                float falloff = 1.0f - std::sqrt(dx * dx + dy * dy) / radius;
+                (*light)[static_cast<size_t>(y) * size.width + x] = static_cast<uint8_t>(std::max(0.0f, falloff) * 255.0f);
+            }
+        }
+        std::string dims = std::to_string(size.width) + "x" + std::to_string(size.height);
+        int64_t count = static_cast<int64_t>(size.width) * size.height;
+
+        // Reference: the same lookup one pixel at a time on the calling thread
+        BenchCase scalar;
+        scalar.name = "applyLightMap/" + dims + "/scalar";
+        scalar.pixelsPerOp = count;
+        scalar.op = [pixels, light, shades]() {
+            shadeIndexedScalar(pixels->data(), light->data(), shades->getLightTable(), pixels->size());
+        };
+        cases.push_back(std::move(scalar));
+
+        BenchCase lit;
+        lit.name = "applyLightMap/" + dims;
+        lit.pixelsPerOp = count;
+        lit.op = [buffer, light, shades, size]() {
+            buffer->applyLightMap(light->data(), size.width, 0, 0, size.width, size.height, *shades);
+        };
+        cases.push_back(std::move(lit));
+    }
+}
+
+void addParallelRowsBenchmarks(std::vector<BenchCase>& cases) {
+    struct Size { int width, height; };
+    const Size sizes[] = {{320, 200}, {1920, 1080}};
+
+    // Plasma: three sine terms from a 256-entry table
+    auto sine = std::make_shared<std::array<uint8_t, 256>>();
+    for (int i = 0; i < 256; ++i) {
+        (*sine)[i] = static_cast<uint8_t>(42.0 + 42.0 * std::sin(i * 6.28318530718 / 256.0));
+    }
+
+    // "serial" pins the pool to the calling thread; "pool" uses every hardware thread
+    struct Mode { const char* name; int threads; };
+    const Mode modes[] = {{"serial", 1}, {"pool", 0}};
+
+    for (const Size& size : sizes) {
+        std::string prefix = "parallelRows/" + std::to_string(size.width) + "x" + std::to_string(size.height) + "/";
+        int64_t pixels = static_cast<int64_t>(size.width) * size.height;
+        auto indexed = std::make_shared<IndexedPixelBuffer>(size.width, size.height);
+        auto rgba = std::make_shared<PixelBuffer>(size.width, size.height);
+        auto frame = std::make_shared<int>(0);
+
+        for (const Mode& mode : modes) {
+            int threads = mode.threads;
+
+            BenchCase plasma;
+            plasma.name = prefix + "plasma/" + mode.name;
+            plasma.pixelsPerOp = pixels;
+            plasma.op = [indexed, sine, frame, threads]() {
+                WorkerPool::getInstance().setThreadCount(threads);
+                int t = ++*frame;
+                int width = indexed->getWidth();
+                const uint8_t* table = sine->data();
+                indexed->parallelForRows([width, table, t](int y, uint8_t* row) {
+                    int rowTerm = table[(y * 2 + t) & 255];
+                    for (int x = 0; x < width; ++x) {
+                        row[x] = static_cast<uint8_t>(table[(x + t) & 255] + rowTerm + table[(x + y + 3 * t) & 255]);
+                    }
+                });
+            };
+            cases.push_back(std::move(plasma));
+
+            // Fire: reads two rows of the previous frame per output row
+            BenchCase fire;
+            fire.name = prefix + "fire/fromPrevious/" + mode.name;
+            fire.pixelsPerOp = pixels;
+            fire.op = [indexed, frame, threads]() {
+                WorkerPool::getInstance().setThreadCount(threads);
+                uint32_t seed = static_cast<uint32_t>(++*frame) * 0x9E3779B1u;
+                int width = indexed->getWidth();
+                int height = indexed->getHeight();
+                indexed->parallelForRowsFromPrevious(
+                    [width, height, seed](int y, uint8_t* row, const ConstRowView<uint8_t>& previous) {
+                        if (y == height - 1) {
+                            for (int x = 0; x < width; ++x) {
+                                row[x] = static_cast<uint8_t>((seed ^ (x * 0x85EBCA77u)) >> 24);
+                            }
+                            return;
+                        }
+                        const uint8_t* below = previous.row(y + 1);
+                        const uint8_t* below2 = previous.row(std::min(y + 2, height - 1));
+                        row[0] = below[0];
+                        row[width - 1] = below[width - 1];
+                        for (int x = 1; x < width - 1; ++x) {
+                            int average = (below[x - 1] + below[x] + below[x + 1] + below2[x]) >> 2;
+                            row[x] = static_cast<uint8_t>(average > 0 ? average - 1 : 0);
+                        }
+                    });
+            };
+            cases.push_back(std::move(fire));
+
+            BenchCase rgbaPlasma;
+            rgbaPlasma.name = prefix + "plasma/rgba/" + mode.name;
+            rgbaPlasma.pixelsPerOp = pixels;
+            rgbaPlasma.op = [rgba, sine, frame, threads]() {
+                WorkerPool::getInstance().setThreadCount(threads);
+                int t = ++*frame;
+                int width = rgba->getWidth();
+                const uint8_t* table = sine->data();
+                rgba->parallelForRows([width, table, t](int y, Color* row) {
+                    uint8_t g = table[(y * 2 + t) & 255];
+                    for (int x = 0; x < width; ++x) {
+                        row[x] = Color{table[(x + t) & 255], g, table[(x + y + 3 * t) & 255], 255};
+                    }
+                });
+            };
+            cases.push_back(std::move(rgbaPlasma));
+        }
+    }
+}
+
+void addDoubleBufferBenchmarks(std::vector<BenchCase>& cases) {
+    struct Size { int width, height; };
+    const Size sizes[] = {{320, 200}, {1920, 1080}};
+
+    // Blur feedback step: each pixel averages its four neighbours in the previous frame
+    auto blurRow = [](const uint8_t* above, const uint8_t* row, const uint8_t* below, uint8_t* dest, int width) {
+        dest[0] = row[0];
+        dest[width - 1] = row[width - 1];
+        for (int x = 1; x < width - 1; ++x) {
+            dest[x] = static_cast<uint8_t>((above[x] + below[x] + row[x - 1] + row[x + 1] + 1) >> 2);
+        }
+    };
+
+    for (const Size& size : sizes) {
+        std::string prefix = "doubleBuffer/" + std::to_string(size.width) + "x" + std::to_string(size.height) + "/blur/";
+        int64_t pixels = static_cast<int64_t>(size.width) * size.height;
+
+        // Single buffer: snapshot the previous frame by hand, then write in place
+        auto single = std::make_shared<IndexedPixelBuffer>(size.width, size.height);
+        auto snapshot = std::make_shared<std::vector<uint8_t>>(static_cast<size_t>(pixels));
+        BenchCase copy;
+        copy.name = prefix + "copy";
+        copy.pixelsPerOp = pixels;
+        copy.op = [single, snapshot, blurRow]() {
+            int width = single->getWidth();
+            int height = single->getHeight();
+            std::memcpy(snapshot->data(), single->getPixelData(), snapshot->size());
+            auto lock = single->lockPixels();
+            for (int y = 0; y < height; ++y) {
+                const uint8_t* row = snapshot->data() + static_cast<size_t>(y) * width;
+                const uint8_t* above = y > 0 ? row - width : row;
+                const uint8_t* below = y + 1 < height ? row + width : row;
+                blurRow(above, row, below, lock.row(y), width);
+            }
+        };
+        cases.push_back(std::move(copy));
+
+        // Double buffer: read the front, write the back, swap
+        auto doubled = std::make_shared<IndexedPixelBuffer>(size.width, size.height);
+        doubled->setDoubleBuffered(true);
+        BenchCase swap;
+        swap.name = prefix + "swap";
+        swap.pixelsPerOp = pixels;
+        swap.op = [doubled, blurRow]() {
+            int width = doubled->getWidth();
+            int height = doubled->getHeight();
+            ConstRowView<uint8_t> front = doubled->getFrontPixels();
+            {
+                auto lock = doubled->lockPixels();
+                for (int y = 0; y < height; ++y) {
+                    blurRow(front.row(std::max(y - 1, 0)), front.row(y),
+                            front.row(std::min(y + 1, height - 1)), lock.row(y), width);
+                }
+            }
+            doubled->swap();
+        };
+        cases.push_back(std::move(swap));
+    }
+}
+
+void addTextGridBenchmarks(std::vector<BenchCase>& cases, const PixelFontPtr& font) {
+    if (!font) {
+        std::cerr << "Skipping AttributedTextGrid benchmarks (font creation failed)" << std::endl;
+        return;
+    }
+
+    const int gridSizes[][2] = {{40, 25}, {80, 25}, {80, 50}, {160, 90}};
+
+    for (const auto& size : gridSizes) {
+        int cols = size[0];
+        int rows = size[1];
+        auto grid = std::make_shared<AttributedTextGrid>(font, cols, rows);
+        auto buffer = grid->getBuffer();
+
+        // Fill with printable glyphs and varied attributes (some spaces)
+        std::mt19937 rng(static_cast<uint32_t>(cols * rows));
+        for (int i = 1; i < 16; ++i) {
+            grid->setAttributeDef(static_cast<uint8_t>(i), static_cast<uint8_t>(i), static_cast<uint8_t>(16 - i));
+        }
+        for (int y = 0; y < rows; ++y) {
+            for (int x = 0; x < cols; ++x) {
+                uint8_t glyph = (rng() % 8 == 0) ? ' ' : static_cast<uint8_t>(33 + rng() % 90);
+                grid->setCell(x, y, glyph, static_cast<uint8_t>(rng() % 16));
+            }
+        }
+
+        BenchCase bench;
+        bench.name = "AttributedTextGrid::renderToBuffer/" + std::to_string(cols) + "x" + std::to_string(rows);
+        bench.pixelsPerOp = static_cast<int64_t>(buffer->getWidth()) * buffer->getHeight();
+        bench.op = [grid, buffer]() {
+            grid->renderToBuffer(*buffer);
+        };
+        cases.push_back(std::move(bench));
+    }
+}
+
+void addRGBABlitBenchmarks(std::vector<BenchCase>& cases, const PixelFontPtr& font) {
+    const int width = 640;
+    const int height = 480;
+    const int decalSize = 32;
+    const int decalCount = 256;
+    auto buffer = std::make_shared<PixelBuffer>(width, height);
+    buffer->clear(Color{20, 30, 40, 255});
+
+    // Soft round decal: opaque core, alpha falling off to zero at the corners
+    auto decal = std::make_shared<PixelBuffer>(decalSize, decalSize);
+    auto premultiplied = std::make_shared<PixelBuffer>(decalSize, decalSize);
+    for (int y = 0; y < decalSize; ++y) {
+        for (int x = 0; x < decalSize; ++x) {
+            float dx = x - decalSize * 0.5f + 0.5f;
+            float dy = y - decalSize * 0.5f + 0.5f;
+            float coverage = std::max(0.0f, std::min(1.0f, 1.6f - std::sqrt(dx * dx + dy * dy) / (decalSize * 0.35f)));
+            uint8_t alpha = static_cast<uint8_t>(coverage * 255.0f);
+            Color color{static_cast<uint8_t>(x * 8), static_cast<uint8_t>(y * 8), 200, alpha};
+            decal->setPixel(x, y, color);
+            premultiplied->setPixel(x, y, Color{static_cast<uint8_t>(color.r * alpha / 255),
+                                                static_cast<uint8_t>(color.g * alpha / 255),
+                                                static_cast<uint8_t>(color.b * alpha / 255), alpha});
+        }
+    }
+
+    // On-screen positions, so the scalar reference below needs no clipping
+    auto positions = std::make_shared<std::vector<std::pair<int, int>>>();
+    std::mt19937 rng(static_cast<uint32_t>(decalCount));
+    for (int i = 0; i < decalCount; ++i) {
+        positions->emplace_back(static_cast<int>(rng() % (width - decalSize + 1)),
+                                static_cast<int>(rng() % (height - decalSize + 1)));
+    }
+    const int64_t decalPixels = static_cast<int64_t>(decalCount) * decalSize * decalSize;
+    const std::string prefix = "PixelBuffer::blit/640x480/decals:" + std::to_string(decalCount) + "x32";
+
+    // Reference: the same arithmetic one pixel at a time, into a plain array
+    auto canvas = std::make_shared<std::vector<Color>>(static_cast<size_t>(width) * height, Color{20, 30, 40, 255});
+    BenchCase scalar;
+    scalar.name = prefix + "/alpha/scalar";
+    scalar.pixelsPerOp = decalPixels;
+    scalar.op = [canvas, decal, positions]() {
+        const Color* src = decal->getPixelData();
+        for (const auto& position : *positions) {
+            for (int y = 0; y < decalSize; ++y) {
+                Color* dest = canvas->data() + static_cast<size_t>(position.second + y) * width + position.first;
+                blendOverRGBAScalar(src + y * decalSize, dest, decalSize, false);
+            }
+        }
+    };
+    cases.push_back(std::move(scalar));
+
+    struct Mode { const char* name; PixelBlend blend; bool premultiplied; };
+    const Mode modes[] = {{"copy", PixelBlend::Copy, false},
+                          {"alpha", PixelBlend::Alpha, false},
+                          {"alpha/premultiplied", PixelBlend::Alpha, true},
+                          {"additive", PixelBlend::Additive, false}};
+    for (const Mode& mode : modes) {
+        PixelBlitOptions options;
+        options.blend = mode.blend;
+        options.premultiplied = mode.premultiplied;
+        auto source = mode.premultiplied ? premultiplied : decal;
+
+        BenchCase bench;
+        bench.name = prefix + "/" + mode.name;
+        bench.pixelsPerOp = decalPixels;
+        bench.op = [buffer, source, positions, options]() {
+            for (const auto& position : *positions) {
+                buffer->blit(*source, position.first, position.second, options);
+            }
+        };
+        cases.push_back(std::move(bench));
+    }
+
+    if (font) {
+        // A screen of 8x8 text: 80 x 60 glyphs
+        auto text = std::make_shared<std::string>();
+        for (int row = 0; row < 60; ++row) {
+            for (int col = 0; col < 80; ++col) {
+                text->push_back(static_cast<char>(33 + (row * 80 + col) % 90));
+            }
+            text->push_back('\n');
+        }
+        BenchCase drawText;
+        drawText.name = "PixelBuffer::drawText/640x480/glyphs:4800";
+        drawText.pixelsPerOp = static_cast<int64_t>(width) * height;
+        drawText.op = [buffer, font, text]() {
+            buffer->drawText(font, *text, 0, 0);
+        };
+        cases.push_back(std::move(drawText));
+    }
+}
+
+void addMeshBenchmarks(std::vector<BenchCase>& cases) {
+    const int segmentCounts[] = {8, 16, 32};
+    const int sizes[][2] = {{320, 200}, {640, 480}};
+    const MeshRenderMode modes[] = {MeshRenderMode::Filled, MeshRenderMode::Wireframe};
+
+    for (const auto& size : sizes) {
+        for (int segments : segmentCounts) {
+            for (MeshRenderMode mode : modes) {
+                int width = size[0];
+                int height = size[1];
+                auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+                auto mesh = Mesh3D::createSphere(static_cast<float>(height) * 0.35f, segments);
+                mesh->setRenderMode(mode);
+                mesh->setPosition(Vec2{width * 0.5f, height * 0.5f});
+                mesh->setRotation(Vec3{0.4f, 0.7f, 0.1f});
+
+                BenchCase bench;
+                bench.name = std::string("Mesh3D::renderToBuffer/") +
+                             (mode == MeshRenderMode::Filled ? "filled/" : "wireframe/") +
+                             std::to_string(width) + "x" + std::to_string(height) +
+                             "/polys:" + std::to_string(mesh->getPolygons().size());
+                bench.pixelsPerOp = static_cast<int64_t>(width) * height;
+                bench.op = [mesh, buffer]() {
+                    buffer->clear(0);
+                    mesh->renderToBuffer(*buffer);
+                };
+                cases.push_back(std::move(bench));
+            }
+        }
+    }
+}
+
+void addPaletteExpandBenchmarks(std::vector<BenchCase>& cases) {
+    const int sizes[][2] = {{320, 200}, {640, 480}, {1280, 720}, {1920, 1080}};
+
+    for (const auto& size : sizes) {
+        int width = size[0];
+        int height = size[1];
+        std::string suffix = std::to_string(width) + "x" + std::to_string(height);
+        size_t count = static_cast<size_t>(width) * height;
+
+        auto buffer = std::make_shared<IndexedPixelBuffer>(width, height);
+        auto palette = Palette::createFireGradient();
+        buffer->setPalette(palette.getColors());
+        {
+            std::mt19937 rng(static_cast<uint32_t>(count));
+            auto pixels = buffer->lockPixels();
+            for (int y = 0; y < height; ++y) {
+                for (int x = 0; x < width; ++x) {
+                    pixels.at(x, y) = static_cast<uint8_t>(rng());
+                }
+            }
+        }
+        auto dest = std::make_shared<std::vector<Color>>(count);
+
+        // Raw kernels: reference scalar loop vs the runtime-selected one
+        BenchCase scalar;
+        scalar.name = "expandIndexed/scalar/" + suffix;
+        scalar.pixelsPerOp = static_cast<int64_t>(count);
+        scalar.op = [buffer, dest, count]() {
+            expandIndexedScalar(buffer->getPixelData(), buffer->getPaletteData(), dest->data(), count);
+        };
+        cases.push_back(std::move(scalar));
+
+        BenchCase dispatched;
+        dispatched.name = std::string("expandIndexed/") + toString(getSimdLevel()) + "/" + suffix;
+        dispatched.pixelsPerOp = static_cast<int64_t>(count);
+        dispatched.op = [buffer, dest, count]() {
+            expandIndexed(buffer->getPixelData(), buffer->getPaletteData(), dest->data(), count);
+        };
+        cases.push_back(std::move(dispatched));
+
+        // Full upload path into a headless streaming texture (conversion + copy)
+        auto renderer = std::make_shared<HeadlessRenderer>();
+        if (renderer->init("engine_bench", width, height)) {
+            BenchCase upload;
+            upload.name = "IndexedPixelBuffer::upload/headless/" + suffix;
+            upload.pixelsPerOp = static_cast<int64_t>(count);
+            upload.op = [buffer, renderer]() {
+                buffer->markPaletteDirty();  // Forces a full-buffer conversion
+                buffer->upload(*renderer);
+            };
+            cases.push_back(std::move(upload));
+
+            // Same conversion through a per-scanline effect table (CPU raster effects)
+            auto effectBuffer = std::make_shared<IndexedPixelBuffer>(width, height);
+            for (int y = 0; y < height; ++y) {
+                effectBuffer->writeRow(y, buffer->getRow(y));
+            }
+            effectBuffer->setPaletteBankCount(2);
+            for (int y = 0; y < height; ++y) {
+                ScanlineEffect effect;
+                effect.paletteBank = static_cast<uint8_t>(y & 1);
+                effect.paletteOffset = static_cast<uint8_t>(y / 8);
+                effect.scrollX = static_cast<int16_t>(y % 17 - 8);
+                effectBuffer->setScanlineEffect(y, effect);
+            }
+
+            BenchCase scanline;
+            scanline.name = "IndexedPixelBuffer::upload/headless+scanlineEffects/" + suffix;
+            scanline.pixelsPerOp = static_cast<int64_t>(count);
+            scanline.op = [effectBuffer, renderer]() {
+                effectBuffer->markPaletteDirty();
+                effectBuffer->upload(*renderer);
+            };
+            cases.push_back(std::move(scanline));
+        }
+    }
+}
+
+// Noisy RGB gradient in memory (same pattern as createBenchImage)
+std::shared_ptr<std::vector<Color>> makeGradientImage(int size) {
+    auto image = std::make_shared<std::vector<Color>>(static_cast<size_t>(size) * size);
+    std::mt19937 rng(static_cast<uint32_t>(size * 31 + size));
+    for (int y = 0; y < size; ++y) {
+        for (int x = 0; x < size; ++x) {
+            uint8_t noise = static_cast<uint8_t>(rng() & 31);
+            (*image)[static_cast<size_t>(y) * size + x] = Color{
+                static_cast<uint8_t>(static_cast<uint8_t>((x * 255) / size) ^ noise),
+                static_cast<uint8_t>((y * 255) / size),
+                static_cast<uint8_t>(((x + y) * 127) / (size + size) + noise), 255};
+        }
+    }
+    return image;
+}
+
+void addQuantizerBenchmarks(std::vector<BenchCase>& cases) {
+    const int imageSizes[] = {64, 256, 512};
+
+    // Palette generation alone, from pixels in memory
+    for (int size : {256, 512, 1024}) {
+        auto image = makeGradientImage(size);
+        BenchCase bench;
+        bench.name = "Palette::createOptimized/" + std::to_string(size) + "x" + std::to_string(size);
+        bench.pixelsPerOp = static_cast<int64_t>(size) * size;
+        bench.op = [image, size]() {
+            Palette palette = Palette::createOptimized(image->data(), size, size, size);
+            (void)palette;
+        };
+        cases.push_back(std::move(bench));
+    }
+
+    for (int size : imageSizes) {
+        std::string path = tempPath("engine_bench_quantize_" + std::to_string(size) + ".bmp");
+        if (!createBenchImage(path, size, size)) {
+            std::cerr << "Skipping quantizer benchmark for " << size << "x" << size
+                      << " (could not write " << path << ")" << std::endl;
+            continue;
+        }
+
+        auto buffer = std::make_shared<IndexedPixelBuffer>(size, size);
+
+        BenchCase bench;
+        bench.name = "IndexedPixelBuffer::loadFromFile/median-cut/" + std::to_string(size) + "x" + std::to_string(size);
+        bench.pixelsPerOp = static_cast<int64_t>(size) * size;
+        bench.op = [buffer, path]() {
+            buffer->loadFromFile(path, 0, 0, true);
+        };
+        cases.push_back(std::move(bench));
+    }
+}
+
+void addColorMapBenchmarks(std::vector<BenchCase>& cases) {
+    const int size = 1024;
+    auto image = makeGradientImage(size);
+    auto palette = std::make_shared<Palette>(Palette::createOptimized(image->data(), size, size, size));
+    auto indices = std::make_shared<std::vector<uint8_t>>(image->size());
+
+    // Reference: the linear scan over all 256 entries that the inverse table replaces
+    BenchCase linear;
+    linear.name = "Palette::mapColors/linear/1024x1024";
+    linear.pixelsPerOp = static_cast<int64_t>(size) * size;
+    linear.op = [image, palette, indices]() {
+        const auto& colors = palette->getColors();
+        for (size_t i = 0; i < image->size(); ++i) {
+            const Color& c = (*image)[i];
+            int best = 0;
+            int bestDistance = INT_MAX;
+            for (int entry = 0; entry < 256; ++entry) {
+                int dr = c.r - colors[entry].r;
+                int dg = c.g - colors[entry].g;
+                int db = c.b - colors[entry].b;
+                int distance = dr * dr + dg * dg + db * db;
+                if (distance < bestDistance) {
+                    bestDistance = distance;
+                    best = entry;
+                }
+            }
+            (*indices)[i] = static_cast<uint8_t>(best);
+        }
+    };
+    cases.push_back(std::move(linear));
+
+    for (bool exact : {true, false}) {
+        BenchCase bench;
+        bench.name = std::string("Palette::mapColors/") + (exact ? "exact" : "fast") + "/1024x1024";
+        bench.pixelsPerOp = static_cast<int64_t>(size) * size;
+        bench.op = [image, palette, indices, exact]() {
+            palette->mapColors(image->data(), indices->data(), image->size(), exact);
+        };
+        cases.push_back(std::move(bench));
+    }
+
+    // Table rebuild after a palette change
+    BenchCase rebuild;
+    rebuild.name = "Palette::getInverseTable/rebuild";
+    rebuild.op = [palette]() {
+        palette->setColor(0, palette->getColor(0));
+        palette->getInverseTable();
+    };
+    cases.push_back(std::move(rebuild));
+
+    auto buffer = std::make_shared<IndexedPixelBuffer>(size, size);
+    buffer->setPalette(palette->getColors());
+    BenchCase copy;
+    copy.name = "IndexedPixelBuffer::copyFromRGBA/1024x1024";
+    copy.pixelsPerOp = static_cast<int64_t>(size) * size;
+    copy.op = [image, buffer, size]() {
+        buffer->copyFromRGBA(image->data(), size, size, size);
+    };
+    cases.push_back(std::move(copy));
+}
+
+void addIndexedImageBenchmarks(std::vector<BenchCase>& cases) {
+    const int size = 1024;
+    auto image = makeGradientImage(size);
+
+    // What loadFromFile does after decoding: fit a palette and map every pixel
+    auto buffer = std::make_shared<IndexedPixelBuffer>(size, size);
+    BenchCase quantize;
+    quantize.name = "IndexedPixelBuffer::loadFromFile/quantize-only/1024x1024";
+    quantize.pixelsPerOp = static_cast<int64_t>(size) * size;
+    quantize.op = [image, buffer, size]() {
+        buffer->setPalette(Palette::createOptimized(image->data(), size, size, size).getColors());
+        buffer->copyFromRGBA(image->data(), size, size, size);
+    };
+    cases.push_back(std::move(quantize));
+
+    buffer->setPalette(Palette::createOptimized(image->data(), size, size, size).getColors());
+    buffer->copyFromRGBA(image->data(), size, size, size);
+    for (bool rle : {false, true}) {
+        std::string path = tempPath(std::string("engine_bench_baked_") + (rle ? "rle" : "raw") + ".idx");
+        if (!buffer->saveToIndexedFile(path, rle)) {
+            std::cerr << "Skipping baked image benchmark (could not write " << path << ")" << std::endl;
+            continue;
+        }
+
+        auto target = std::make_shared<IndexedPixelBuffer>(size, size);
+        BenchCase bench;
+        bench.name = std::string("IndexedPixelBuffer::loadFromIndexedFile/") + (rle ? "rle" : "raw") + "/1024x1024";
+        bench.pixelsPerOp = static_cast<int64_t>(size) * size;
+        bench.op = [target, path]() {
+            target->loadFromIndexedFile(path);
+        };
+        cases.push_back(std::move(bench));
+    }
+}
+
+void cleanupTempFiles() {
+    std::error_code ec;
+    for (int size : {64, 256, 512}) {
+        std::filesystem::remove(tempPath("engine_bench_quantize_" + std::to_string(size) + ".bmp"), ec);
+    }
+    std::filesystem::remove(tempPath("engine_bench_baked_raw.idx"), ec);
+    std::filesystem::remove(tempPath("engine_bench_baked_rle.idx"), ec);
+}
+
+void printUsage(const char* argv0) {
+    std::cout << "Usage: " << argv0 << " [--filter <substring>] [--min-time <seconds>] [--json <file>]" << std::endl;
+}
+
+} // anonymous namespace
+
+int main(int argc, char* argv[]) {
+    std::string filter;
+    std::string jsonPath;
+    double minTime = 0.25;
+
+    for (int i = 1; i < argc; ++i) {
+        std::string arg = argv[i];
+        if (arg == "--filter" && i + 1 < argc) {
+            filter = argv[++i];
+        } else if (arg == "--min-time" && i + 1 < argc) {
+            minTime = std::atof(argv[++i]);
+        } else if (arg == "--json" && i + 1 < argc) {
+            jsonPath = argv[++i];
+        } else {
+            printUsage(argv[0]);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    std::vector<BenchCase> cases;
+    addFillTriangleBenchmarks(cases);
+    addFillPolygonBenchmarks(cases);
+    addDrawLineBenchmarks(cases);
+    addBlitBenchmarks(cases);
+    addBlendBenchmarks(cases);
+    addLightingBenchmarks(cases);
+    addParallelRowsBenchmarks(cases);
+    addDoubleBufferBenchmarks(cases);
+    PixelFontPtr font = createBenchFont();
+    addTextGridBenchmarks(cases, font);
+    addRGBABlitBenchmarks(cases, font);
+    addMeshBenchmarks(cases);
+    addPaletteExpandBenchmarks(cases);
+    addQuantizerBenchmarks(cases);
+    addColorMapBenchmarks(cases);
+    addIndexedImageBenchmarks(cases);
+
+    std::vector<BenchResult> results;
+    std::printf("%-64s %12s %14s %12s %12s %10s\n", "benchmark", "ns/op", "Mpixels/s", "allocs/op", "bytes/op", "iters");
+    for (const auto& bench : cases) {
+        if (!filter.empty() && bench.name.find(filter) == std::string::npos) {
+            continue;
+        }
+
+        BenchResult result = runCase(bench, minTime);
+        std::printf("%-64s %12.0f %14.2f %12.2f %12.0f %10llu\n",
+                    result.name.c_str(), result.nsPerOp, result.pixelsPerSecond / 1e6,
+                    result.allocsPerOp, result.allocBytesPerOp,
+                    static_cast<unsigned long long>(result.iterations));
+        std::fflush(stdout);
+        results.push_back(result);
+    }
+
+    cleanupTempFiles();
+
+    if (!jsonPath.empty()) {
+        std::ofstream out(jsonPath);
+        if (!out) {
+            std::cerr << "Failed to write " << jsonPath << std::endl;
+            return 1;
+        }
+        out << "{\n  \"benchmarks\": [\n";
+        for (size_t i = 0; i < results.size(); ++i) {
+            const auto& r = results[i];
+            out << "    {\"name\": \"" << r.name << "\""
+                << ", \"iterations\": " << r.iterations
+                << ", \"ns_per_op\": " << r.nsPerOp
+                << ", \"pixels_per_second\": " << r.pixelsPerSecond
+                << ", \"allocs_per_op\": " << r.allocsPerOp
+                << ", \"alloc_bytes_per_op\": " << r.allocBytesPerOp << "}"
+                << (i + 1 < results.size() ? ",\n" : "\n");
+        }
+        out << "  ]\n}\n";
+    }
+
+    return 0;
+}
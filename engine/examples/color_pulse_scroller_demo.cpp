@@ -12,6 +12,7 @@
 #include <SDL.h>
 #include <iostream>
 #include <cmath>
+#include <vector>
 
 // Classic scroller with palette-based color pulsing
 class ColorPulseScroller : public Engine::GameObject,
@@ -71,6 +72,16 @@ public:
             c64Palette[i] = Engine::Color{gray, gray, gray, 255};
         }
 
+        // Copper gradient (indices 32-63): rows outside the text band show
+        // index 0 shifted into this range by their scanline palette offset
+        for (int i = 0; i < 32; ++i) {
+            float t = std::sin(i / 32.0f * 3.14159265f);
+            c64Palette[32 + i] = Engine::Color{static_cast<uint8_t>(40 * t),
+                                               static_cast<uint8_t>(20 * t),
+                                               static_cast<uint8_t>(60 + 140 * t), 255};
+        }
+        scanlines_.resize(200);
+
         screen_->setPalette(c64Palette);
 
         // Add to first layer
@@ -92,6 +103,29 @@ public:
 
         // Pulse the palette color for index 1 (our text color)
         updatePalettePulse();
+
+        // Raster split: copper gradient above and below the text, wobble on it
+        updateRasterEffects();
+    }
+
+    void updateRasterEffects() {
+        int charHeight = font_->getCharHeight();
+        int textTop = 100 - charHeight / 2;
+        int gradientScroll = static_cast<int>(time_ * 40.0f);
+
+        for (int y = 0; y < 200; ++y) {
+            Engine::ScanlineEffect& line = scanlines_[y];
+            if (y >= textTop && y < textTop + charHeight) {
+                line.paletteOffset = 0;
+                line.scrollX = static_cast<int16_t>(std::sin(time_ * 4.0f + y * 0.4f) * 4.0f);
+            } else {
+                line.paletteOffset = static_cast<uint8_t>(32 + ((y + gradientScroll) & 31));
+                line.scrollX = 0;
+            }
+        }
+
+        // Only this 200-entry table is uploaded for the effect (GL evaluates it in the palette shader)
+        screen_->setScanlineEffects(scanlines_.data());
     }
 
     void renderScrollText() {
@@ -158,6 +192,7 @@ public:
 
 private:
     std::shared_ptr<Engine::IndexedPixelBuffer> screen_;
+    std::vector<Engine::ScanlineEffect> scanlines_;
     Engine::PixelFontPtr font_;
     float time_ = 0.0f;
     float scrollX_ = 320.0f;  // Start off-screen to the right
@@ -229,6 +264,7 @@ int main(int argc, char* argv[]) {
     std::cout << "  - Horizontal scrolling text" << std::endl;
     std::cout << "  - Palette-based color pulsing" << std::endl;
     std::cout << "  - Rainbow color cycle" << std::endl;
+    std::cout << "  - Per-scanline copper gradient and wobble (raster effects)" << std::endl;
     std::cout << "\nControls:" << std::endl;
     std::cout << "  ESC - Quit\n" << std::endl;
 
@@ -16,11 +16,14 @@
 class FireEffect : public Engine::GameObject,
                    public Engine::IUpdateable {
 public:
-    FireEffect() : GameObject("FireEffect"), rng_(std::random_device{}()), dist_(0, 255) {}
+    FireEffect() : GameObject("FireEffect") {}
 
     void onAttached() override {
         LOG_INFO("FireEffect attached!");
 
+        // Engine seed is fixed in replay mode so the flames are reproducible
+        rng_.seed(getEngine()->getRandomSeed());
+
         // Create a chunky pixel buffer - low res for that retro look!
         fire_ = std::make_shared<Engine::IndexedPixelBuffer>(160, 120);
         fire_->setPosition(Engine::Vec2{240, 180});  // Center it
@@ -46,58 +49,57 @@ public:
         int width = fire_->getWidth();
         int height = fire_->getHeight();
 
-        // Add random "heat sources" at the bottom row
-        for (int x = 0; x < width; ++x) {
-            // Random heat intensity at bottom
-            uint8_t heat = dist_(rng_);
-            fire_->setPixel(x, height - 1, heat);
-        }
-
-        // Propagate fire upward with cooling
-        for (int y = 0; y < height - 1; ++y) {
-            for (int x = 0; x < width; ++x) {
-                // Sample pixels below and around current position
-                int sum = 0;
-                int count = 0;
-
-                // Pixel directly below
-                if (y + 1 < height) {
-                    sum += fire_->getPixel(x, y + 1);
-                    count++;
-                }
-
-                // Pixel below-left
-                if (x > 0 && y + 1 < height) {
-                    sum += fire_->getPixel(x - 1, y + 1);
-                    count++;
-                }
-
-                // Pixel below-right
-                if (x < width - 1 && y + 1 < height) {
-                    sum += fire_->getPixel(x + 1, y + 1);
-                    count++;
+        // One draw from the engine-seeded generator per frame; per-pixel noise is
+        // hashed from it so rows can run on any thread and replays stay identical
+        uint32_t frameSeed = static_cast<uint32_t>(rng_());
+
+        // Each row is computed from the previous frame's rows below it, in parallel
+        // row bands; the buffer is marked dirty once when all bands are done
+        fire_->parallelForRowsFromPrevious(
+            [width, height, frameSeed](int y, uint8_t* row, const Engine::ConstRowView<uint8_t>& previous) {
+                // Add random "heat sources" at the bottom row
+                if (y == height - 1) {
+                    for (int x = 0; x < width; ++x) {
+                        row[x] = static_cast<uint8_t>(noise(frameSeed, x, y));
+                    }
+                    return;
                 }
 
-                // Pixel two rows below for more vertical spread
-                if (y + 2 < height) {
-                    sum += fire_->getPixel(x, y + 2);
-                    count++;
-                }
+                // Propagate fire upward with cooling
+                const uint8_t* below = previous.row(y + 1);
+                const uint8_t* below2 = (y + 2 < height) ? previous.row(y + 2) : nullptr;
+
+                for (int x = 0; x < width; ++x) {
+                    // Sample pixels below and around current position
+                    int sum = below[x];
+                    int count = 1;
+
+                    // Pixel below-left
+                    if (x > 0) {
+                        sum += below[x - 1];
+                        count++;
+                    }
+
+                    // Pixel below-right
+                    if (x < width - 1) {
+                        sum += below[x + 1];
+                        count++;
+                    }
+
+                    // Pixel two rows below for more vertical spread
+                    if (below2) {
+                        sum += below2[x];
+                        count++;
+                    }
 
-                if (count > 0) {
                     // Average and cool down
                     int average = sum / count;
 
                     // Cooling factor - flames get cooler as they rise
-                    int cooling = 3 + (dist_(rng_) & 7);  // Random 3-10
-                    int newHeat = std::max(0, average - cooling);
-
-                    fire_->setPixel(x, y, static_cast<uint8_t>(newHeat));
-                } else {
-                    fire_->setPixel(x, y, 0);
+                    int cooling = 3 + (noise(frameSeed, x, y) & 7);  // Random 3-10
+                    row[x] = static_cast<uint8_t>(std::max(0, average - cooling));
                 }
-            }
-        }
+            });
     }
 
     void onDestroy() override {
@@ -110,9 +112,19 @@ public:
     }
 
 private:
+    // Stateless 0-255 noise for (frame, x, y) - safe to call from worker threads
+    static uint32_t noise(uint32_t seed, int x, int y) {
+        uint32_t h = seed ^ (static_cast<uint32_t>(x) * 0x9E3779B1u) ^ (static_cast<uint32_t>(y) * 0x85EBCA77u);
+        h ^= h >> 15;
+        h *= 0x2C1B3C6Du;
+        h ^= h >> 12;
+        h *= 0x297A2D39u;
+        h ^= h >> 15;
+        return h & 0xFF;
+    }
+
     std::shared_ptr<Engine::IndexedPixelBuffer> fire_;
     std::mt19937 rng_;
-    std::uniform_int_distribution<int> dist_;
 };
 
 // Simple FPS counter
@@ -150,6 +162,11 @@ int main(int argc, char* argv[]) {
     config.showFrame = true;
     config.showLogLevel = true;
 
+    // --replay <frames> runs a fixed-timestep benchmark and writes a JSON report
+    if (!Engine::parseReplayArgs(argc, argv, config)) {
+        return 1;
+    }
+
     // Create engine with GLRenderer for shader-based palette rendering
     Engine::Engine engine;
 
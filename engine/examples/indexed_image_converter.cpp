@@ -0,0 +1,65 @@
+#include "engine/IndexedPixelBuffer.h"
+#include "engine/Palette.h"
+#include <SDL_image.h>
+#include <cstring>
+#include <iostream>
+#include <string>
+
+// Bakes an image (PNG, GIF, BMP, ...) into the indexed .idx format that
+// IndexedPixelBuffer::loadFromFile loads without decoding or quantizing
+// The palette is fitted to the image unless --palette names a shared palette
+// file (see Palette::loadFromFile); pixels are then mapped onto that palette.
+int main(int argc, char* argv[]) {
+    std::string input;
+    std::string output;
+    std::string palettePath;
+    bool rle = true;
+    for (int i = 1; i < argc; ++i) {
+        if (std::strcmp(argv[i], "--raw") == 0) {
+            rle = false;
+        } else if (std::strcmp(argv[i], "--palette") == 0 && i + 1 < argc) {
+            palettePath = argv[++i];
+        } else if (input.empty()) {
+            input = argv[i];
+        } else if (output.empty()) {
+            output = argv[i];
+        } else {
+            input.clear();
+            break;
+        }
+    }
+    if (input.empty() || output.empty()) {
+        std::cerr << "Usage: indexed_image_converter <input.png> <output.idx> [--palette <file>] [--raw]" << std::endl;
+        return 1;
+    }
+
+    // Size the buffer to the image
+    SDL_Surface* surface = IMG_Load(input.c_str());
+    if (!surface) {
+        std::cerr << "Failed to load: " << input << " - " << IMG_GetError() << std::endl;
+        return 1;
+    }
+    int width = surface->w;
+    int height = surface->h;
+    SDL_FreeSurface(surface);
+
+    Engine::IndexedPixelBuffer buffer(width, height);
+    bool fitPalette = palettePath.empty();
+    if (!fitPalette) {
+        Engine::Palette palette;
+        if (!palette.loadFromFile(palettePath)) {
+            return 1;
+        }
+        buffer.setPalette(palette.getColors());
+    }
+
+    if (!buffer.loadFromFile(input, 0, 0, fitPalette)) {
+        return 1;
+    }
+    if (!buffer.saveToIndexedFile(output, rle)) {
+        return 1;
+    }
+
+    std::cout << "Wrote " << output << " (" << width << "x" << height << ")" << std::endl;
+    return 0;
+}
@@ -172,6 +172,11 @@ int main(int argc, char* argv[]) {
     config.showFrame = true;
     config.showLogLevel = true;
 
+    // --replay <frames> runs a fixed-timestep benchmark and writes a JSON report
+    if (!Engine::parseReplayArgs(argc, argv, config)) {
+        return 1;
+    }
+
     // Create and initialize engine
     Engine::Engine engine;
     if (!engine.init(config)) {
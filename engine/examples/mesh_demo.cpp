@@ -175,7 +175,10 @@ public:
 
         timeSinceUpdate_ += deltaTime;
         if (timeSinceUpdate_ >= 1.0f) {
-            LOG_INFO_FMT("FPS: %.1f | Mesh3D Demo", fpsCounter_.getFPS());
+            auto stats = fpsCounter_.getStats().getSummary();
+            LOG_INFO_FMT("FPS: %.1f | p50 %.2f ms | p99 %.2f ms | max %.2f ms | hitches %llu | Mesh3D Demo",
+                         fpsCounter_.getFPS(), stats.p50Ms, stats.p99Ms, stats.maxMs,
+                         static_cast<unsigned long long>(stats.hitches));
             timeSinceUpdate_ = 0.0f;
         }
     }
@@ -198,6 +201,11 @@ int main(int argc, char* argv[]) {
     config.showFrame = true;
     config.showLogLevel = true;
 
+    // --replay <frames> runs a fixed-timestep benchmark and writes a JSON report
+    if (!Engine::parseReplayArgs(argc, argv, config)) {
+        return 1;
+    }
+
     // Create engine with GLRenderer
     Engine::Engine engine;
 
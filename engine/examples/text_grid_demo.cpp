@@ -263,6 +263,11 @@ int main(int argc, char* argv[]) {
     config.showFrame = true;
     config.showLogLevel = true;
 
+    // --replay <frames> runs a fixed-timestep benchmark and writes a JSON report
+    if (!Engine::parseReplayArgs(argc, argv, config)) {
+        return 1;
+    }
+
     // Create engine with GLRenderer
     Engine::Engine engine;
 
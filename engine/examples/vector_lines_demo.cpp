@@ -226,10 +226,21 @@ public:
             palette[i] = Engine::Color{gray, gray, gray, 255};
         }
 
+        // Horizontal bars are raster effects on a blank buffer behind the scroller:
+        // every row stays index 0 and its palette offset selects the bar color,
+        // so only the 200-entry scanline table changes per frame
+        copper_ = std::make_shared<Engine::IndexedPixelBuffer>(320, 200);
+        copper_->setPosition(Engine::Vec2{0, 0});
+        copper_->setScale(3.0f);
+        copper_->setPalette(palette);
+        scanlines_.resize(200);
+
+        palette[0] = Engine::Color{0, 0, 0, 0};  // Scroller background shows the copper buffer
         screen_->setPalette(palette);
 
         auto& layers = getEngine()->getLayers();
         if (layers.size() > 0) {
+            layers[0]->addIndexedPixelBuffer(copper_);
             layers[0]->addIndexedPixelBuffer(screen_);
         }
 
@@ -302,12 +313,10 @@ public:
                   [](CopperBar* a, CopperBar* b) { return a->depth > b->depth; });
 
         // Draw bars in depth order
+        std::fill(scanlines_.begin(), scanlines_.end(), Engine::ScanlineEffect{});
         for (auto* bar : sortedBars) {
-            // Calculate sine wave offset
-            float sineOffset = std::sin(time_ * bar->sineSpeed + bar->sinePhase) * bar->sineAmplitude;
-
             if (bar->isVertical) {
-                // Draw vertical gradient bar with sine wave
+                // Vertical gradient bar: one solid column per gradient step
                 for (int x = 0; x < bar->size; ++x) {
                     int screenX = static_cast<int>(bar->pos) + x;
                     if (screenX < 0 || screenX >= 320) continue;
@@ -315,47 +324,20 @@ public:
                     // Calculate gradient position (0 to 31)
                     int gradientPos = (x * 32) / bar->size;
                     uint8_t colorIndex = bar->paletteStart + gradientPos;
-
-                    // Draw vertical line with sine wave distortion
-                    for (int y = 0; y < 200; ++y) {
-                        // Apply sine wave based on X position within the bar
-                        float xProgress = static_cast<float>(x) / bar->size;
-                        int yOffset = static_cast<int>(sineOffset * xProgress);
-                        int screenY = y + yOffset;
-
-                        // Wrap around vertically
-                        if (screenY < 0) screenY += 200;
-                        if (screenY >= 200) screenY -= 200;
-
-                        screen_->setPixel(screenX, screenY, colorIndex);
-                    }
+                    screen_->fillRect(screenX, 0, 1, 200, colorIndex);
                 }
             } else {
-                // Draw horizontal gradient bar with sine wave
+                // Horizontal gradient bar: one scanline table entry per row
                 for (int y = 0; y < bar->size; ++y) {
                     int screenY = static_cast<int>(bar->pos) + y;
                     if (screenY < 0 || screenY >= 200) continue;
 
-                    // Calculate gradient position (0 to 31)
                     int gradientPos = (y * 32) / bar->size;
-                    uint8_t colorIndex = bar->paletteStart + gradientPos;
-
-                    // Draw horizontal line with sine wave distortion
-                    for (int x = 0; x < 320; ++x) {
-                        // Apply sine wave based on Y position within the bar
-                        float yProgress = static_cast<float>(y) / bar->size;
-                        int xOffset = static_cast<int>(sineOffset * yProgress);
-                        int screenX = x + xOffset;
-
-                        // Wrap around horizontally
-                        if (screenX < 0) screenX += 320;
-                        if (screenX >= 320) screenX -= 320;
-
-                        screen_->setPixel(screenX, screenY, colorIndex);
-                    }
+                    scanlines_[screenY].paletteOffset = static_cast<uint8_t>(bar->paletteStart + gradientPos);
                 }
             }
         }
+        copper_->setScanlineEffects(scanlines_.data());
     }
 
     void onDestroy() override {
@@ -363,12 +345,15 @@ public:
             auto& layers = getEngine()->getLayers();
             if (!layers.empty()) {
                 layers[0]->removeIndexedPixelBuffer(screen_);
+                layers[0]->removeIndexedPixelBuffer(copper_);
             }
         }
     }
 
 private:
     std::shared_ptr<Engine::IndexedPixelBuffer> screen_;
+    std::shared_ptr<Engine::IndexedPixelBuffer> copper_;  // Blank; drawn through scanlines_
+    std::vector<Engine::ScanlineEffect> scanlines_;
     Engine::PixelFontPtr font_;
     float time_ = 0.0f;
     float scrollX_ = 320.0f;
@@ -407,6 +392,13 @@ public:
             palette[i] = Engine::Color{gray, gray, gray, 255};
         }
 
+        // Face fills: a dark shade of each line color at index + kFillOffset
+        for (int i = 1; i <= 6; ++i) {
+            const Engine::Color& line = palette[i];
+            palette[i + kFillOffset] = Engine::Color{static_cast<uint8_t>(line.r / 4), static_cast<uint8_t>(line.g / 4),
+                                                     static_cast<uint8_t>(line.b / 4), 255};
+        }
+
         vectorLayer_->setPalette(palette);
 
         auto& layers = getEngine()->getLayers();
@@ -453,6 +445,8 @@ public:
         // View direction (camera looking down -Z axis)
         Vec3 viewDir(0, 0, -1);
 
+        std::vector<Engine::Vec2> outline;
+
         // Draw each polygon with back-face culling
         for (const auto& poly : mesh.polygons) {
             if (poly.vertices.size() < 3) continue;
@@ -474,34 +468,24 @@ public:
                 continue;  // Back face, skip it
             }
 
-            // Draw polygon edges
-            for (size_t i = 0; i < poly.vertices.size(); ++i) {
-                int v0Idx = poly.vertices[i];
-                int v1Idx = poly.vertices[(i + 1) % poly.vertices.size()];
-
-                Vec3 p0 = transformed[v0Idx];
-                Vec3 p1 = transformed[v1Idx];
+            // Project the polygon outline, fill the face and trace its edges
+            outline.clear();
+            for (int vIdx : poly.vertices) {
+                Vec3 p = transformed[vIdx];
 
                 // Perspective projection
                 float focalLength = 200.0f;  // Camera distance
                 float cameraZ = 150.0f;      // Push objects away from camera
 
-                // Apply perspective division
-                float z0 = p0.z + cameraZ;
-                float z1 = p1.z + cameraZ;
-
-                // Avoid division by zero
-                if (z0 < 1.0f) z0 = 1.0f;
-                if (z1 < 1.0f) z1 = 1.0f;
-
-                // Project to 2D with perspective
-                int x0 = centerX + static_cast<int>((p0.x * focalLength) / z0);
-                int y0 = centerY + static_cast<int>((p0.y * focalLength) / z0);
-                int x1 = centerX + static_cast<int>((p1.x * focalLength) / z1);
-                int y1 = centerY + static_cast<int>((p1.y * focalLength) / z1);
+                // Apply perspective division, avoiding division by zero
+                float z = p.z + cameraZ;
+                if (z < 1.0f) z = 1.0f;
 
-                vectorLayer_->drawLine(x0, y0, x1, y1, poly.color);
+                outline.push_back(Engine::Vec2{centerX + (p.x * focalLength) / z,
+                                               centerY + (p.y * focalLength) / z});
             }
+            vectorLayer_->fillPolygon(outline.data(), outline.size(), static_cast<uint8_t>(poly.color + kFillOffset));
+            vectorLayer_->drawPolyline(outline.data(), outline.size(), poly.color, true);
         }
     }
 
@@ -515,6 +499,8 @@ public:
     }
 
 private:
+    static constexpr int kFillOffset = 8;
+
     std::shared_ptr<Engine::IndexedPixelBuffer> vectorLayer_;
     Mesh3D cube_;
     Mesh3D pyramid_;
@@ -555,6 +541,11 @@ int main(int argc, char* argv[]) {
     config.showFrame = true;
     config.showLogLevel = true;
 
+    // --replay <frames> runs a fixed-timestep benchmark and writes a JSON report
+    if (!Engine::parseReplayArgs(argc, argv, config)) {
+        return 1;
+    }
+
     Engine::Engine engine;
 
     auto glRenderer = std::make_unique<Engine::GLRenderer>();
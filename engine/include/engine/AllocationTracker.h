@@ -0,0 +1,163 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Heap allocation tracking replaces the global operator new/delete and is off
+// by default. Define ENGINE_ALLOC_TRACKING=1 (CMake: -DENGINE_ENABLE_ALLOC_TRACKING=ON)
+// to compile the hooks in; without it the tracker API still links but reports zeros.
+#ifndef ENGINE_ALLOC_TRACKING
+    #define ENGINE_ALLOC_TRACKING 0
+#endif
+
+namespace Engine {
+
+// What the audit does with an allocation inside an audited scope after warm-up
+enum class AllocationAuditAction {
+    Log,    // Count it; the frame's violations are logged at the next frame boundary
+    Abort   // Print the zone to stderr and abort() at the allocation site (break in a debugger)
+};
+
+// Per-frame heap allocation counters
+// Every operator new/delete on any thread is counted into the current frame;
+// allocations are also attributed to the innermost ALLOC_SCOPE / PROFILE_ZONE of
+// the allocating thread. The hooks themselves never allocate: zone statistics
+// live in a fixed-size open-addressed table keyed by the (string literal) name.
+class AllocationTracker {
+public:
+    struct FrameCounters {
+        uint64_t allocations = 0;
+        uint64_t frees = 0;
+        uint64_t bytes = 0;            // Bytes requested by allocations
+        uint64_t auditViolations = 0;  // Allocations inside audited scopes after warm-up
+    };
+
+    struct ZoneCounters {
+        const char* name = nullptr;
+        uint64_t allocations = 0;
+        uint64_t bytes = 0;
+    };
+
+    // Distinct zone names tracked; allocations in further zones count as "(other)"
+    static constexpr size_t kMaxZones = 256;
+
+    static AllocationTracker& getInstance() {
+        static AllocationTracker instance;
+        return instance;
+    }
+
+    // True when the operator new/delete hooks are compiled in
+    static constexpr bool isCompiledIn() { return ENGINE_ALLOC_TRACKING != 0; }
+
+    // Frame boundary: publishes the finished frame (getLastFrame / getLastFrameZones),
+    // reports audit violations and resets the per-frame counters.
+    // Call outside audited scopes - reporting may allocate.
+    void beginFrame();
+
+    const FrameCounters& getLastFrame() const { return lastFrame_; }
+    FrameCounters getCurrentFrame() const;  // Live counters of the frame in progress
+    FrameCounters getTotals() const;
+    uint64_t getFrameIndex() const { return frameIndex_; }
+
+    // Zones of the last finished frame that allocated, most allocations first
+    const std::vector<ZoneCounters>& getLastFrameZones() const { return lastFrameZones_; }
+
+    // Zero-allocation audit
+    // Allocations inside an AllocationAuditScope are violations once warmupFrames
+    // frames have passed (caches, pools and scratch buffers fill up during warm-up)
+    void setAuditEnabled(bool enabled) { auditEnabled_.store(enabled, std::memory_order_relaxed); }
+    bool isAuditEnabled() const { return auditEnabled_.load(std::memory_order_relaxed); }
+    void setAuditWarmupFrames(uint64_t frames) { auditWarmupFrames_ = frames; }
+    void setAuditAction(AllocationAuditAction action) { auditAction_ = action; }
+
+    // Hook entry points (called from the operator new/delete replacements)
+    void onAllocate(size_t bytes);
+    void onFree();
+
+private:
+    struct ZoneSlot {
+        std::atomic<const char*> name{nullptr};
+        std::atomic<uint64_t> allocations{0};
+        std::atomic<uint64_t> bytes{0};
+    };
+
+    AllocationTracker() = default;
+    AllocationTracker(const AllocationTracker&) = delete;
+    AllocationTracker& operator=(const AllocationTracker&) = delete;
+
+    ZoneSlot& findZone(const char* name);
+    void reportViolations(const FrameCounters& frame, const char* firstZone);
+
+    // Current frame (all threads)
+    std::atomic<uint64_t> allocations_{0};
+    std::atomic<uint64_t> frees_{0};
+    std::atomic<uint64_t> bytes_{0};
+    std::atomic<uint64_t> violations_{0};
+    std::atomic<const char*> firstViolationZone_{nullptr};
+    ZoneSlot zones_[kMaxZones];
+    ZoneSlot overflowZone_;
+
+    // Finished frames (main thread)
+    FrameCounters lastFrame_;
+    FrameCounters totals_;
+    std::vector<ZoneCounters> lastFrameZones_;
+    uint64_t frameIndex_ = 0;
+
+    std::atomic<bool> auditEnabled_{false};
+    std::atomic<bool> auditArmed_{false};  // Enabled and past warm-up
+    uint64_t auditWarmupFrames_ = 120;
+    AllocationAuditAction auditAction_ = AllocationAuditAction::Log;
+};
+
+// RAII attribution scope - allocations on this thread are charged to name
+// (must be a string literal) until the scope ends
+class AllocationScope {
+public:
+    explicit AllocationScope(const char* name);
+    ~AllocationScope();
+
+    AllocationScope(const AllocationScope&) = delete;
+    AllocationScope& operator=(const AllocationScope&) = delete;
+
+    // Innermost scope name on the calling thread (nullptr outside any scope)
+    static const char* current();
+
+private:
+    const char* previous_;
+};
+
+// RAII audited region - while any is open on a thread (and the audit is armed),
+// allocations on that thread are violations. Engine opens one around update()
+// and render() when EngineConfig::allocationAudit is set.
+class AllocationAuditScope {
+public:
+    AllocationAuditScope();
+    ~AllocationAuditScope();
+
+    AllocationAuditScope(const AllocationAuditScope&) = delete;
+    AllocationAuditScope& operator=(const AllocationAuditScope&) = delete;
+
+    // Suspend auditing on this thread (e.g. for a deliberate one-off allocation)
+    class Suspend {
+    public:
+        Suspend();
+        ~Suspend();
+        Suspend(const Suspend&) = delete;
+        Suspend& operator=(const Suspend&) = delete;
+    private:
+        int savedDepth_;
+    };
+};
+
+} // namespace Engine
+
+// Attribution macro (name must be a string literal); PROFILE_ZONE attributes too
+#if ENGINE_ALLOC_TRACKING
+    #define ENGINE_ALLOC_CONCAT_INNER(a, b) a##b
+    #define ENGINE_ALLOC_CONCAT(a, b) ENGINE_ALLOC_CONCAT_INNER(a, b)
+    #define ALLOC_SCOPE(name) ::Engine::AllocationScope ENGINE_ALLOC_CONCAT(allocScope_, __LINE__)(name)
+#else
+    #define ALLOC_SCOPE(name) do {} while (0)
+#endif
@@ -0,0 +1,48 @@
+#pragma once
+
+#include <array>
+#include <cstdint>
+#include <memory>
+
+namespace Engine {
+
+class Palette;
+
+// Blend equations for BlendTable (per RGB channel, alpha a in [0, 255] as a fraction)
+enum class BlendMode : uint8_t {
+    Alpha,     // src * a + dest * (1 - a)
+    Additive,  // dest + src * a, saturating
+    Multiply,  // dest * src, faded in by a
+    Subtract   // dest - src * a, saturating
+};
+
+// Precomputed translucency for indexed pixels: blend(src, dest) is the palette
+// entry nearest to the blended colors of the two entries. One 64 KB table covers
+// one (palette, mode, alpha); drawing through it costs a table load per pixel.
+// Tables are immutable snapshots - they stay valid (and shareable between
+// buffers and threads) after the palette changes, but then blend the old colors.
+class BlendTable {
+public:
+    // Builds a table from the palette's current colors (a few ms, in parallel on
+    // the WorkerPool). Palette::getBlendTable caches the result per palette.
+    static std::shared_ptr<const BlendTable> create(const Palette& palette, BlendMode mode, uint8_t alpha = 128);
+
+    uint8_t blend(uint8_t src, uint8_t dest) const { return table_[(src << 8) | dest]; }
+
+    // 256 results for one source index, indexed by the destination index
+    const uint8_t* row(uint8_t src) const { return &table_[src << 8]; }
+
+    BlendMode getMode() const { return mode_; }
+    uint8_t getAlpha() const { return alpha_; }
+
+private:
+    BlendTable(BlendMode mode, uint8_t alpha) : mode_(mode), alpha_(alpha) {}
+
+    std::array<uint8_t, 256 * 256> table_;  // [src << 8 | dest]
+    BlendMode mode_;
+    uint8_t alpha_;
+};
+
+using BlendTablePtr = std::shared_ptr<const BlendTable>;
+
+} // namespace Engine
@@ -6,6 +6,8 @@
 #include "Input.h"
 #include "ResourceManager.h"
 #include "Logger.h"
+#include "Replay.h"
+#include "AllocationTracker.h"
 #include <vector>
 #include <memory>
 #include <algorithm>
@@ -35,6 +37,27 @@ struct EngineConfig {
     bool showWallClock = true;
     bool showFrame = true;
     bool showLogLevel = true;
+    bool asyncLogging = false;  // Format and write log records on a background thread
+
+    // Profiler settings (see Profiler.h)
+    bool enableProfiler = false;
+    std::string profilerTracePath;  // If set, a Chrome trace is written on shutdown
+
+    // Zero-allocation audit (needs ENGINE_ALLOC_TRACKING, see AllocationTracker.h)
+    // Heap allocations inside update()/render() after the warm-up frames are reported
+    bool allocationAudit = false;
+    int allocationAuditWarmupFrames = 120;
+    AllocationAuditAction allocationAuditAction = AllocationAuditAction::Log;
+
+    // Threads for parallel row kernels, including the main thread (see WorkerPool.h)
+    // 0 = one per hardware thread, 1 = run them serially
+    int workerThreads = 0;
+
+    // Presentation
+    bool vsync = true;  // false asks the renderer to present without waiting for vblank
+
+    // Deterministic replay/benchmark mode (see Replay.h)
+    ReplayConfig replay;
 };
 
 class Engine {
@@ -70,6 +93,7 @@ public:
 
     // Main frame update (call this every frame)
     // If deltaTime < 0 (default), automatically calculates delta time from last frame
+    // In replay mode the replay deltaTime is always used
     void update(float deltaTime = -1.0f);
 
     // Rendering
@@ -84,6 +108,7 @@ public:
 
     // Getters
     IRenderer& getRenderer() { return *renderer_; }
+    const RenderStats& getRenderStats() const { return renderer_->getRenderStats(); }  // Last presented frame
     const std::vector<std::shared_ptr<Layer>>& getLayers() const { return layers_; }
     const std::vector<GameObjectPtr>& getGameObjects() const { return gameObjects_; }
 
@@ -94,6 +119,14 @@ public:
     void setFixedTimestep(float timestep) { fixedTimestep_ = timestep; }
     float getFixedTimestep() const { return fixedTimestep_; }
 
+    // Seed for game-side RNGs: the replay seed in replay mode, random otherwise
+    uint32_t getRandomSeed() const { return randomSeed_; }
+
+    // Replay mode: the engine stops itself (isRunning() == false) after the
+    // configured frame count and writes the report
+    bool isReplayMode() const { return replay_ != nullptr; }
+    const ReplayRecorder* getReplayRecorder() const { return replay_.get(); }
+
     // Debug mode
     void setDebugMode(bool debug) { debugMode_ = debug; }
     bool isDebugMode() const { return debugMode_; }
@@ -107,6 +140,7 @@ private:
     void fixedUpdate();
     void cleanupDestroyedObjects();
     void cacheInterfacePointers(GameObjectPtr object);
+    void finishReplay();
 
     RendererPtr renderer_;
     std::vector<std::shared_ptr<Layer>> layers_;
@@ -119,6 +153,7 @@ private:
     std::vector<std::pair<GameObjectPtr, IFixedUpdateable*>> fixedUpdateables_;
     std::vector<std::pair<GameObjectPtr, IInputHandler*>> inputHandlers_;
     std::vector<std::pair<GameObjectPtr, IRenderable*>> renderables_;
+    std::vector<std::pair<GameObject*, IRenderable*>> sortedRenderables_;  // render() scratch
     std::vector<std::pair<GameObjectPtr, ICollidable*>> collidables_;
     std::vector<std::pair<GameObjectPtr, IOnDebug*>> debugObjects_;
 
@@ -134,6 +169,15 @@ private:
 
     bool running_ = false;
     bool debugMode_ = false;
+
+    std::string profilerTracePath_;
+
+    // Replay/benchmark state (null unless EngineConfig::replay is enabled)
+    std::unique_ptr<ReplayRecorder> replay_;
+    std::vector<Color> replayPixels_;  // final-frame readback, reused
+    std::string title_;
+    bool vsync_ = true;
+    uint32_t randomSeed_ = 0;
 };
 
 // Template implementation
@@ -1,13 +1,16 @@
 #pragma once
 
+#include "FrameStats.h"
 #include <SDL.h>
-#include <deque>
+#include <vector>
 
 namespace Engine {
 
 class FPSCounter {
 public:
-    FPSCounter(int sampleSize = 60);
+    // sampleSize: frames averaged for getFPS()/getFrameTime()
+    // statsCapacity: frames kept for percentile/histogram statistics
+    FPSCounter(int sampleSize = 60, size_t statsCapacity = 1024);
 
     // Call this once per frame
     void update();
@@ -21,16 +24,24 @@ public:
     // Get delta time in seconds (time since last frame)
     float getDeltaTime() const { return deltaTime_; }
 
+    // Detailed frame-time statistics (p50/p95/p99/max, histogram, hitches)
+    FrameStats& getStats() { return stats_; }
+    const FrameStats& getStats() const { return stats_; }
+
     // Reset the counter
     void reset();
 
 private:
-    int sampleSize_;
-    std::deque<Uint32> frameTimes_;
-    Uint32 lastFrameTime_;
+    std::vector<float> frameTimes_;  // Ring buffer of the last sampleSize frame times (ms)
+    size_t nextSample_ = 0;
+    size_t sampleCount_ = 0;
+    double frameTimeSum_ = 0.0;
+    Uint64 lastCounter_;
+    double counterToMs_;
     float currentFPS_;
     float frameTime_;
     float deltaTime_;
+    FrameStats stats_;
 };
 
 } // namespace Engine
@@ -0,0 +1,81 @@
+#pragma once
+
+#include <SDL.h>
+#include <cstdint>
+#include <vector>
+
+namespace Engine {
+
+// High-resolution frame-time statistics over a sliding window
+// Uses SDL_GetPerformanceCounter and a fixed-size ring buffer (no allocation
+// per frame). Reports percentiles, a histogram and hitches against a frame
+// budget - averages hide the 1% lows players notice.
+class FrameStats {
+public:
+    struct Summary {
+        size_t samples = 0;     // Samples in the current window
+        float meanMs = 0.0f;
+        float minMs = 0.0f;
+        float p50Ms = 0.0f;
+        float p95Ms = 0.0f;
+        float p99Ms = 0.0f;
+        float maxMs = 0.0f;
+        uint64_t hitches = 0;   // Lifetime frames over budget
+        uint64_t totalFrames = 0;
+    };
+
+    // capacity: number of most recent frames kept for percentiles/histogram
+    // budgetMs: frame budget used for hitch detection (default 60 Hz)
+    explicit FrameStats(size_t capacity = 1024, float budgetMs = 1000.0f / 60.0f);
+
+    // Call once per frame; records the time since the previous tick()
+    // The first call only starts the clock
+    void tick();
+
+    // Record an externally measured frame time (e.g. fixed-step replays)
+    void addSample(float frameTimeMs);
+
+    // Frame budget for hitch detection
+    void setBudget(float budgetMs) { budgetMs_ = budgetMs; }
+    float getBudget() const { return budgetMs_; }
+
+    // Most recent frame time in milliseconds
+    float getLastFrameTime() const { return lastFrameMs_; }
+
+    // Nearest-rank percentile over the window (p in [0, 100])
+    float getPercentile(float p) const;
+
+    // All statistics in one pass
+    Summary getSummary() const;
+
+    // Histogram of the window: bucketCount buckets of bucketWidthMs each,
+    // the last bucket also collects everything slower
+    void computeHistogram(float bucketWidthMs, int bucketCount, std::vector<uint32_t>& out) const;
+
+    uint64_t getHitchCount() const { return hitchCount_; }
+    uint64_t getTotalFrames() const { return totalFrames_; }
+    size_t getSampleCount() const { return count_; }
+    size_t getCapacity() const { return samples_.size(); }
+
+    // Clear samples and counters (capacity and budget are kept)
+    void reset();
+
+private:
+    // Copy the window into the sort scratch buffer and sort it
+    void sortWindow() const;
+
+    std::vector<float> samples_;              // Ring buffer of frame times (ms)
+    mutable std::vector<float> sortScratch_;  // Preallocated, reused for percentiles
+    size_t head_ = 0;                         // Next write position
+    size_t count_ = 0;                        // Valid samples (<= capacity)
+
+    float budgetMs_;
+    float lastFrameMs_ = 0.0f;
+    uint64_t hitchCount_ = 0;
+    uint64_t totalFrames_ = 0;
+
+    Uint64 lastCounter_ = 0;
+    double counterToMs_;
+};
+
+} // namespace Engine
@@ -3,9 +3,12 @@
 #include "IRenderer.h"
 #include <SDL.h>
 #include <string>
+#include <vector>
 
 namespace Engine {
 
+struct ScanlineEffect;
+
 // OpenGL-based renderer implementation with shader support
 class GLRenderer : public IRenderer {
 public:
@@ -45,17 +48,27 @@ public:
     int getViewportWidth() const override { return windowWidth_; }
     int getViewportHeight() const override { return windowHeight_; }
 
+    bool setVSync(bool enabled) override;
+    bool readPixels(std::vector<Color>& pixels) override;
+
     // IndexedPixelBuffer GL-specific support
     unsigned int createIndexedTexture(int width, int height);
     unsigned int createPaletteTexture();
-    void updateIndexedTexture(unsigned int textureId, const uint8_t* indices, int width, int height);
-    void updatePaletteTexture(unsigned int textureId, const Color* palette);
+    // Uploads the [x, y, width, height] sub-rectangle of an index buffer whose rows are pitch bytes apart
+    void updateIndexedTexture(unsigned int textureId, const uint8_t* indices, int pitch,
+                              int x, int y, int width, int height);
+    // Uploads one 256-color palette bank (a row of the palette texture)
+    void updatePaletteTexture(unsigned int textureId, const Color* palette, int bank = 0);
+    unsigned int createScanlineTexture(int height);
+    // Uploads the scanline table (banks >= bankCount are remapped to bank 0)
+    void updateScanlineTexture(unsigned int textureId, const ScanlineEffect* effects, int height, int bankCount);
 
 private:
     bool initOpenGL();
     bool compileShaders();
     void renderQuad(unsigned int texture, const Vec2& position, const Vec2& size, float rotation = 0.0f);
     void renderIndexedQuad(unsigned int indexTexture, unsigned int paletteTexture,
+                          unsigned int scanlineTexture, int bufferWidth, int bufferHeight,
                           const Vec2& position, const Vec2& size, float opacity = 1.0f);
 
     SDL_Window* window_ = nullptr;
@@ -70,6 +83,8 @@ private:
     // VAO/VBO for quad rendering
     unsigned int quadVAO_ = 0;
     unsigned int quadVBO_ = 0;
+
+    std::vector<int16_t> scanlineStaging_;  // updateScanlineTexture conversion, reused
 };
 
 } // namespace Engine
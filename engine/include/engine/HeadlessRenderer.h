@@ -0,0 +1,99 @@
+#pragma once
+
+#include "IRenderer.h"
+#include <vector>
+
+namespace Engine {
+
+// CPU-only renderer that composites into an in-memory RGBA framebuffer
+// No window, GPU or display is required, which makes it suitable for CI,
+// golden-image tests and benchmarks. Follows the same layer order and
+// opacity semantics as the windowed backends (source-over alpha blending).
+class HeadlessRenderer : public IRenderer {
+public:
+    HeadlessRenderer() = default;
+    ~HeadlessRenderer() override = default;
+
+    // Non-copyable, non-movable (textures hold pointers into renderer-owned storage)
+    HeadlessRenderer(const HeadlessRenderer&) = delete;
+    HeadlessRenderer& operator=(const HeadlessRenderer&) = delete;
+    HeadlessRenderer(HeadlessRenderer&&) = delete;
+    HeadlessRenderer& operator=(HeadlessRenderer&&) = delete;
+
+    // IRenderer interface
+    // The title is ignored; width/height define the framebuffer size
+    bool init(const std::string& title, int width, int height) override;
+    void shutdown() override;
+    bool isInitialized() const override { return initialized_; }
+
+    void clear() override;
+    void present() override;
+
+    void renderSprite(const Sprite& sprite, const Vec2& layerOffset = Vec2{0.0f, 0.0f}, float opacity = 1.0f) override;
+    void renderTilemap(const Tilemap& tilemap, const Vec2& layerOffset = Vec2{0.0f, 0.0f}, float opacity = 1.0f) override;
+    void renderText(const Text& text, const Vec2& position, float opacity = 1.0f) override;
+    void renderPixelBuffer(const PixelBuffer& buffer, const Vec2& layerOffset = Vec2{0.0f, 0.0f}, float opacity = 1.0f) override;
+    void renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, const Vec2& layerOffset = Vec2{0.0f, 0.0f}, float opacity = 1.0f) override;
+
+    TexturePtr createStreamingTexture(int width, int height) override;
+    void updateTexture(Texture& texture, const Color* pixels, int width, int height) override;
+    bool updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) override;
+    bool loadTextureFromFile(Texture& texture, const std::string& path) override;
+
+    // There is no native context; textures live in CPU memory
+    void* getBackendContext() override { return nullptr; }
+
+    // Viewport dimensions
+    int getViewportWidth() const override { return width_; }
+    int getViewportHeight() const override { return height_; }
+
+    // Never waits for a display, so vsync can only be "disabled"
+    bool setVSync(bool enabled) override { return !enabled; }
+    bool readPixels(std::vector<Color>& pixels) override;
+
+    // Framebuffer access (row-major: y * width + x)
+    const std::vector<Color>& getFramebuffer() const { return framebuffer_; }
+    Color getPixel(int x, int y) const;
+
+    // Color used by clear() (opaque black by default, like the SDL/GL backends)
+    void setClearColor(const Color& color) { clearColor_ = color; }
+    const Color& getClearColor() const { return clearColor_; }
+
+    // Number of frames presented since init()
+    uint64_t getFrameCount() const { return frameCount_; }
+
+    // Save the current framebuffer as a PNG image (for golden-image comparisons)
+    bool saveToFile(const std::string& path) const;
+
+private:
+    // CPU-side storage behind a Texture handle created by this renderer
+    struct HeadlessTexture {
+        int width = 0;
+        int height = 0;
+        std::vector<Color> pixels;
+    };
+
+    // Nearest-neighbour copy of a texture region into a destination rectangle
+    void drawTextureRect(const HeadlessTexture& texture,
+                         int srcX, int srcY, int srcW, int srcH,
+                         int dstX, int dstY, int dstW, int dstH,
+                         float rotation, int opacity);
+
+    static int toOpacity(float opacity);
+
+    // Every composite is counted like one textured quad on a GPU backend
+    void countQuad(const void* source) {
+        ++frameStats_.drawCalls;
+        ++frameStats_.quads;
+        countTextureBind(source);
+    }
+
+    std::vector<Color> framebuffer_;
+    Color clearColor_{0, 0, 0, 255};
+    int width_ = 0;
+    int height_ = 0;
+    uint64_t frameCount_ = 0;
+    bool initialized_ = false;
+};
+
+} // namespace Engine
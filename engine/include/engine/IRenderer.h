@@ -2,8 +2,10 @@
 
 #include "Types.h"
 #include "Texture.h"
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Engine {
 
@@ -13,6 +15,20 @@ class Text;
 class PixelBuffer;
 class IndexedPixelBuffer;
 
+// Per-frame counters reported by every backend
+// Counts are API-level: what this renderer submitted, not what the driver did
+struct RenderStats {
+    uint32_t drawCalls = 0;         // Draw commands (SDL_RenderCopy, glDrawArrays, vkCmdDrawIndexed, ...)
+    uint32_t quads = 0;             // Textured quads submitted
+    uint32_t textureBinds = 0;      // Texture binds/changes
+    uint32_t descriptorBinds = 0;   // Descriptor set binds (Vulkan)
+    uint32_t pipelineSwitches = 0;  // Pipeline / shader program changes
+    uint32_t textureUploads = 0;    // CPU -> GPU texture updates
+    uint64_t uploadBytes = 0;       // Bytes transferred by those updates
+
+    void reset() { *this = RenderStats{}; }
+};
+
 // Abstract renderer interface - can be implemented for SDL, Vulkan, headless, etc.
 class IRenderer {
 public:
@@ -38,12 +54,64 @@ public:
     virtual TexturePtr createStreamingTexture(int width, int height) = 0;
     virtual void updateTexture(Texture& texture, const Color* pixels, int width, int height) = 0;
 
+    // Update a sub-rectangle of a streaming texture; pixels holds width*height
+    // tightly packed colors. Returns false if the backend has no partial update
+    // (callers then fall back to updateTexture with the full image).
+    virtual bool updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) {
+        (void)texture; (void)pixels; (void)x; (void)y; (void)width; (void)height;
+        return false;
+    }
+
+    // Load an image file into a texture owned by this backend
+    // The default implementation creates an SDL_Texture via the SDL_Renderer
+    // backend context; backends with their own texture storage override it
+    virtual bool loadTextureFromFile(Texture& texture, const std::string& path);
+
     // Backend-specific context (for texture loading, etc.)
     virtual void* getBackendContext() = 0;
 
     // Viewport dimensions
     virtual int getViewportWidth() const = 0;
     virtual int getViewportHeight() const = 0;
+
+    // Toggle waiting for vblank in present()
+    // Returns false if the backend cannot change it at runtime
+    virtual bool setVSync(bool enabled) { (void)enabled; return false; }
+
+    // Read back the frame being rendered (call before present())
+    // Fills viewport width * height pixels, top row first; returns false if unsupported
+    virtual bool readPixels(std::vector<Color>& pixels) { (void)pixels; return false; }
+
+    // Statistics of the last presented frame
+    // Counters are reset in clear() and published in present()
+    const RenderStats& getRenderStats() const { return lastFrameStats_; }
+
+    // Counters of the frame currently being recorded
+    const RenderStats& getCurrentRenderStats() const { return frameStats_; }
+
+protected:
+    void beginFrameStats() {
+        frameStats_.reset();
+        lastBoundTexture_ = nullptr;
+    }
+    void endFrameStats() { lastFrameStats_ = frameStats_; }
+
+    // Count a texture bind only when the texture actually changes
+    void countTextureBind(const void* texture) {
+        if (texture != lastBoundTexture_) {
+            ++frameStats_.textureBinds;
+            lastBoundTexture_ = texture;
+        }
+    }
+
+    void countUpload(uint64_t bytes) {
+        ++frameStats_.textureUploads;
+        frameStats_.uploadBytes += bytes;
+    }
+
+    RenderStats frameStats_;
+    RenderStats lastFrameStats_;
+    const void* lastBoundTexture_ = nullptr;
 };
 
 using RendererPtr = std::unique_ptr<IRenderer>;
@@ -3,22 +3,97 @@
 #include "Types.h"
 #include "Texture.h"
 #include "Palette.h"
+#include "BlendTable.h"
+#include "ShadeTable.h"
 #include "PixelFont.h"
 #include "ILayerAttachable.h"
+#include "WorkerPool.h"
 #include <vector>
 #include <memory>
 #include <array>
+#include <algorithm>
+#include <cstddef>
 #include <string>
 
 namespace Engine {
 
 class IRenderer;
 
+// Options for IndexedPixelBuffer::blit
+struct BlitOptions {
+    int transparentIndex = -1;       // Source index left undrawn (color key); -1 copies every pixel
+    bool flipX = false;              // Mirror the source rectangle horizontally
+    bool flipY = false;              // Mirror the source rectangle vertically
+    const uint8_t* remap = nullptr;  // Optional 256-entry table applied to copied indices
+    const BlendTable* blend = nullptr;  // Optional translucency: dest = blend(src, dest), after remap
+};
+
+// Which regions of a self-intersecting outline IndexedPixelBuffer::fillPolygon fills
+enum class FillRule : uint8_t {
+    NonZero,  // Inside where the outline winds around the point at least once
+    EvenOdd   // Inside where a ray from the point crosses the outline an odd number of times
+};
+
+// Per-scanline raster effect (see IndexedPixelBuffer::setScanlineEffect)
+// Applied when the buffer is displayed; the stored pixels are not modified.
+struct ScanlineEffect {
+    uint8_t paletteBank = 0;    // Palette bank for the line (0 = the main palette)
+    uint8_t paletteOffset = 0;  // Added to every index on the line, wrapping at 256
+    int16_t scrollX = 0;        // Shifts the line right by this many pixels, wrapping around
+};
+
 // A bitmap buffer using indexed color (256-color palette)
 // Perfect for retro graphics, palette effects, and demoscene tricks
 // Each pixel is a single byte indexing into a 256-color palette
 class IndexedPixelBuffer : public ILayerAttachable {
 public:
+    // Writable view of the raw pixel indices returned by lockPixels()
+    // No bounds checks: callers must stay inside [0, width) x [0, height).
+    // Rows are getPitch() bytes apart. The locked region is marked dirty once, when
+    // the lock is released (destroyed), instead of on every write.
+    class PixelLock {
+    public:
+        ~PixelLock() {
+            if (buffer_) {
+                buffer_->markPixelsDirty(dirtyX_, dirtyY_, dirtyWidth_, dirtyHeight_);
+            }
+        }
+
+        PixelLock(PixelLock&& other) noexcept
+            : buffer_(other.buffer_), data_(other.data_)
+            , width_(other.width_), height_(other.height_), pitch_(other.pitch_)
+            , dirtyX_(other.dirtyX_), dirtyY_(other.dirtyY_)
+            , dirtyWidth_(other.dirtyWidth_), dirtyHeight_(other.dirtyHeight_) {
+            other.buffer_ = nullptr;
+        }
+
+        PixelLock(const PixelLock&) = delete;
+        PixelLock& operator=(const PixelLock&) = delete;
+        PixelLock& operator=(PixelLock&&) = delete;
+
+        uint8_t* data() const { return data_; }
+        uint8_t* row(int y) const { return data_ + static_cast<ptrdiff_t>(y) * pitch_; }
+        uint8_t& at(int x, int y) const { return row(y)[x]; }
+
+        int getWidth() const { return width_; }
+        int getHeight() const { return height_; }
+        int getPitch() const { return pitch_; }
+
+    private:
+        friend class IndexedPixelBuffer;
+        PixelLock(IndexedPixelBuffer& buffer, uint8_t* data, int width, int height, int pitch,
+                  int dirtyX, int dirtyY, int dirtyWidth, int dirtyHeight)
+            : buffer_(&buffer), data_(data), width_(width), height_(height), pitch_(pitch)
+            , dirtyX_(dirtyX), dirtyY_(dirtyY), dirtyWidth_(dirtyWidth), dirtyHeight_(dirtyHeight) {}
+
+        IndexedPixelBuffer* buffer_;
+        uint8_t* data_;
+        int width_;
+        int height_;
+        int pitch_;
+        int dirtyX_, dirtyY_, dirtyWidth_, dirtyHeight_;  // Region marked dirty on release
+    };
+
     IndexedPixelBuffer(int width, int height);
     ~IndexedPixelBuffer() = default;
 
@@ -26,20 +101,139 @@ public:
     void setPixel(int x, int y, uint8_t paletteIndex);
     uint8_t getPixel(int x, int y) const;
 
+    // Unchecked access for effect loops (see PixelLock)
+    // Typical use: { auto pixels = buffer.lockPixels(); ... pixels.row(y)[x] = c; }
+    // The region overload only marks that rectangle dirty - callers promise not to
+    // write outside it (coordinates in the view stay buffer-relative)
+    PixelLock lockPixels() { return lockPixels(0, 0, width_, height_); }
+    PixelLock lockPixels(int x, int y, int width, int height) {
+        return PixelLock(*this, pixels_.data(), width_, height_, width_, x, y, width, height);
+    }
+    const uint8_t* getRow(int y) const { return pixels_.data() + static_cast<ptrdiff_t>(y) * width_; }
+    int getPitch() const { return width_; }  // Bytes between rows
+
+    // Bulk row copies (clipped to the buffer; count < 0 means "to the end of the row")
+    // readRow fills positions outside the buffer with index 0, like getPixel
+    void readRow(int y, uint8_t* dest, int x = 0, int count = -1) const;
+    void writeRow(int y, const uint8_t* src, int x = 0, int count = -1);
+
+    // Parallel row kernels: rows are split into cache-sized bands that run on the
+    // WorkerPool threads, then the whole buffer is marked dirty once.
+    // kernel(y, row) writes its own row through the pointer only - setPixel and the
+    // drawing primitives update shared dirty state and must not be called from it.
+    template <typename Kernel>
+    void parallelForRows(Kernel&& kernel);
+    // Variant for effects that read the previous frame (fire, blur feedback,
+    // cellular automata): kernel(y, row, previous) may read any row of previous
+    // (a ConstRowView<uint8_t>) and must write every pixel of row. Single-buffered,
+    // the result goes to a scratch array that is then swapped in (no copy), so
+    // pointers from getRow(), getPixelData() or a PixelLock taken before the call
+    // go stale. Double-buffered, previous is the front and row the back buffer;
+    // call swap() to show the result.
+    template <typename Kernel>
+    void parallelForRowsFromPrevious(Kernel&& kernel);
+
+    // Double buffering
+    // The renderer uploads the front buffer while every write API (setPixel,
+    // drawing, blits, lockPixels, row kernels) and getPixel/getRow/readRow use the
+    // back buffer. Back-buffer writes touch no shared state, so a worker thread can
+    // draw the next frame while the main thread renders; palette and scanline
+    // changes stay on the main thread. swap() exchanges the buffers in O(1) and
+    // marks the whole front dirty; call it on the main thread once the writer is
+    // done. The back then holds the frame from two swaps ago.
+    // Enabling copies the current pixels into both buffers.
+    void setDoubleBuffered(bool enabled);
+    bool isDoubleBuffered() const { return doubleBuffered_; }
+    void swap();
+    ConstRowView<uint8_t> getFrontPixels() const {
+        return {getPixelData(), width_, height_, width_};
+    }
+
     // Drawing primitives
+    // Lines are clipped to the buffer before rasterization (off-buffer parts cost
+    // nothing) and are inclusive of both endpoints. Vec2 positions select the
+    // pixel containing them, as for fillTriangle.
     void drawLine(int x0, int y0, int x1, int y1, uint8_t paletteIndex);
+    void drawLine(const Vec2& p0, const Vec2& p1, uint8_t paletteIndex);
+    // Batched lines over an array of points: a connected chain (closed adds the
+    // last-to-first segment), or independent segments points[0]-points[1], points[2]-points[3], ...
+    void drawPolyline(const Vec2* points, size_t count, uint8_t paletteIndex, bool closed = false);
+    void drawLines(const Vec2* points, size_t count, uint8_t paletteIndex);
+    // Triangles use a fixed-point (1/16 pixel) edge-function rasterizer with a
+    // top-left fill rule, so triangles sharing an edge neither overlap nor crack.
+    // Integer vertices sit at pixel centers; the Vec2 overload takes sub-pixel
+    // positions where pixel (x, y) covers [x, x+1) x [y, y+1).
     void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint8_t paletteIndex);
+    void fillTriangle(const Vec2& p0, const Vec2& p1, const Vec2& p2, uint8_t paletteIndex);
     void fillRect(int x, int y, int width, int height, uint8_t paletteIndex);  // Optimized rectangle fill
+    // Polygons of any shape - convex, concave or self-intersecting, closed
+    // implicitly - in a single scanline pass over an active edge table. Vertices
+    // snap to the same 1/16 pixel grid as fillTriangle and use its fill
+    // convention, so a polygon covers exactly the pixels of its triangulation.
+    void fillPolygon(const Vec2* points, size_t count, uint8_t paletteIndex, FillRule rule = FillRule::NonZero);
+
+    // Translucent fills: every covered pixel becomes blend.blend(paletteIndex, pixel)
+    // (see getBlendTable; blits take a table through BlitOptions::blend)
+    void fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint8_t paletteIndex, const BlendTable& blend);
+    void fillTriangle(const Vec2& p0, const Vec2& p1, const Vec2& p2, uint8_t paletteIndex, const BlendTable& blend);
+    void fillRect(int x, int y, int width, int height, uint8_t paletteIndex, const BlendTable& blend);
+    void fillPolygon(const Vec2* points, size_t count, uint8_t paletteIndex, const BlendTable& blend,
+                     FillRule rule = FillRule::NonZero);
+
+    // Blitter: copy a source rectangle to (destX, destY), clipped against both buffers
+    // Each option combination runs its own row kernel; color-keyed copies without
+    // flip or remap use SIMD masked stores. The transparent index is tested before
+    // remapping. Blitting a buffer onto itself is allowed (regions may overlap).
+    void blit(const IndexedPixelBuffer& source, int srcX, int srcY, int width, int height,
+              int destX, int destY, const BlitOptions& options = BlitOptions());
+    void blit(const IndexedPixelBuffer& source, int destX, int destY,
+              const BlitOptions& options = BlitOptions()) {
+        blit(source, 0, 0, source.width_, source.height_, destX, destY, options);
+    }
+
+    // Lighting: every pixel of the width x height region at (x, y) is replaced by
+    // its shade at the matching light map value (shades.light(pixel, light)).
+    // Light rows are lightPitch bytes apart and light[0] lights pixel (x, y); the
+    // region is clipped to the buffer and rows run in parallel bands (AVX2 gathers
+    // where available). For one light level everywhere, blit or remap through
+    // shades.getLevel(level) instead.
+    void applyLightMap(const uint8_t* light, int lightPitch, int x, int y, int width, int height,
+                       const ShadeTable& shades);
 
     // Bulk operations
     void clear(uint8_t paletteIndex = 0);
     void fill(uint8_t paletteIndex);
 
     // Load image file into the buffer at specified position
-    // Automatically fits a 256-color palette using median-cut quantization
+    // Automatically fits a 256-color palette (see Palette::createOptimized)
+    // Baked indexed images (see loadFromIndexedFile) are detected by their
+    // extension and loaded without decoding or quantizing.
     // Returns true on success, false on failure
     bool loadFromFile(const std::string& imagePath, int destX = 0, int destY = 0, bool fitPalette = true);
 
+    // Baked indexed image (.idx, written by saveToIndexedFile or the
+    // indexed_image_converter tool), all fields little-endian:
+    //   32-byte header (magic "IDX8", version, compression, width, height, plane size),
+    //   256 RGBA palette entries, then the index plane - raw rows, or for RLE a
+    //   table of height uint32 row offsets followed by PackBits rows (control
+    //   n < 128: n + 1 literal bytes follow; n >= 128: the next byte repeats 257 - n times)
+    // The file is memory-mapped and rows decode straight into the buffer (in
+    // parallel bands), clipped at (destX, destY). usePalette = false keeps the
+    // current palette and copies the stored indices unchanged. A corrupt file
+    // returns false before the palette or pixels are touched.
+    bool loadFromIndexedFile(const std::string& path, int destX = 0, int destY = 0, bool usePalette = true);
+
+    // Write the pixels and palette as a baked indexed image. rle = true stores
+    // PackBits rows unless that would not make the file smaller.
+    bool saveToIndexedFile(const std::string& path, bool rle = true) const;
+
+    // Convert RGBA pixels (rows pitch pixels apart) to the nearest palette entries
+    // and write them at (destX, destY), clipped to the buffer. Large images are
+    // mapped in parallel row bands. exact = false trades exactness for one table
+    // load per pixel (see Palette::findNearestFast).
+    void copyFromRGBA(const Color* pixels, int width, int height, int pitch,
+                      int destX = 0, int destY = 0, bool exact = true);
+
     // Load a palette resource into the buffer
     void loadPalette(const PalettePtr& palette);
 
@@ -55,7 +249,35 @@ public:
     // Set entire 256-color palette at once
     void setPalette(const std::array<Color, 256>& palette);
     void setPalette(const Color* paletteData);  // Must point to 256 colors
-    const std::array<Color, 256>& getPalette() const { return palette_; }
+    const std::array<Color, 256>& getPalette() const { return palette_.getColors(); }
+
+    // Blend table for the current palette, cached with it (see Palette::getBlendTable)
+    BlendTablePtr getBlendTable(BlendMode mode, uint8_t alpha = 128) const {
+        return palette_.getBlendTable(mode, alpha);
+    }
+
+    // Palette banks: extra 256-color palettes selected per scanline
+    // Bank 0 is the main palette above; new banks start as a copy of it.
+    static constexpr int kMaxPaletteBanks = 16;
+    void setPaletteBankCount(int count);  // Clamped to [1, kMaxPaletteBanks]
+    int getPaletteBankCount() const { return paletteBankCount_; }
+    void setPaletteBank(int bank, const std::array<Color, 256>& palette);
+    void setPaletteBankEntry(int bank, uint8_t index, const Color& color);
+    const Color* getPaletteBankData(int bank) const;  // Banks out of range read bank 0
+
+    // Per-scanline raster effects (copper lists, raster splits, wobble scrolls)
+    // One ScanlineEffect per row. GLRenderer evaluates the table in its palette
+    // shader, so a frame that only changes the table uploads height * 8 bytes;
+    // the CPU conversion paths (SDL, Vulkan, headless) apply it while expanding.
+    // The table is allocated on first use; clearScanlineEffects() drops it.
+    void setScanlineEffect(int y, const ScanlineEffect& effect);  // Ignored outside the buffer
+    void setScanlineEffects(const ScanlineEffect* effects);       // height entries
+    void clearScanlineEffects();
+    const ScanlineEffect* getScanlineEffects() const {
+        return scanlineEffects_.empty() ? nullptr : scanlineEffects_.data();
+    }
+    bool areScanlineEffectsDirty() const { return scanlineEffectsDirty_; }
+    void markScanlineEffectsClean() { scanlineEffectsDirty_ = false; }
 
     // Upload pixel data to GPU texture (call after modifying pixels or palette)
     // This converts indexed colors to RGBA using the current palette
@@ -93,25 +315,60 @@ public:
     unsigned int getGLPaletteTexture() const { return glPaletteTexture_; }
     void setGLIndexTexture(unsigned int tex) { glIndexTexture_ = tex; }
     void setGLPaletteTexture(unsigned int tex) { glPaletteTexture_ = tex; }
+    unsigned int getGLScanlineTexture() const { return glScanlineTexture_; }
+    void setGLScanlineTexture(unsigned int tex) { glScanlineTexture_ = tex; }
 
     // Separate dirty tracking for GL shader path
+    // Double-buffered, writes to the back buffer are not tracked: markPixelsDirty()
+    // does nothing and swap() marks the whole buffer
     bool arePixelsDirty() const { return pixelsDirty_; }
     bool isPaletteDirty() const { return paletteDirty_; }
-    void markPixelsDirty() { pixelsDirty_ = true; dirty_ = true; }
+    void markPixelsDirty() { markPixelsDirty(0, 0, width_, height_); }
+    void markPixelsDirty(int x, int y, int width, int height);  // Clipped to the buffer
     void markPaletteDirty() { paletteDirty_ = true; dirty_ = true; }
     void markPixelsClean() { pixelsDirty_ = false; }
     void markPaletteClean() { paletteDirty_ = false; }
 
-    // Direct access to pixel and palette data (for GL upload)
-    const uint8_t* getPixelData() const { return pixels_.data(); }
-    const Color* getPaletteData() const { return palette_.data(); }
+    // Dirty rectangle tracking (for partial uploads)
+    // Bounding box of all pixel writes since the pixels were last marked clean.
+    // DirtyRect is inclusive in pixel-space: [minX..maxX], [minY..maxY]; only
+    // meaningful while arePixelsDirty() is true.
+    struct DirtyRect { int minX, minY, maxX, maxY; };
+    DirtyRect getDirtyRect() const { return {dirtyMinX_, dirtyMinY_, dirtyMaxX_, dirtyMaxY_}; }
+
+    // Direct access to pixel and palette data (for GL upload; the front buffer
+    // when double-buffered)
+    const uint8_t* getPixelData() const { return doubleBuffered_ ? frontPixels_.data() : pixels_.data(); }
+    const Color* getPaletteData() const { return palette_.getColors().data(); }
 
 private:
     int width_;
     int height_;
-    std::vector<uint8_t> pixels_;  // width * height palette indices
-    std::array<Color, 256> palette_;  // 256-color palette
+    std::vector<uint8_t> pixels_;  // width * height palette indices (the back buffer when double-buffered)
+    std::vector<uint8_t> frontPixels_;  // Displayed pixels while double-buffered
+    bool doubleBuffered_ = false;
+    Palette palette_;  // 256-color palette (and its cached inverse table)
+    std::vector<Color> paletteBanks_;  // Banks 1.., 256 colors each
+    int paletteBankCount_ = 1;
+    std::vector<ScanlineEffect> scanlineEffects_;  // Empty until an effect is set
+    std::array<Color, 256> offsetPalette_;  // upload(): bank rotated by a line's paletteOffset
+    int offsetPaletteKey_ = -1;             // (bank << 8 | offset) held in offsetPalette_
     TexturePtr texture_;  // For SDL renderer (CPU-based conversion)
+    std::vector<Color> staging_;  // upload() RGBA conversion target, reused across frames
+    std::vector<uint8_t> blitScratch_;  // Source copy for blits within this buffer
+    std::vector<uint8_t> nextPixels_;   // parallelForRowsFromPrevious() target, swapped with pixels_
+
+    // fillPolygon edge: the first pixel column at or right of its crossing with
+    // the current row, stepped per row as a quotient and remainder
+    struct PolygonEdge {
+        int64_t column, remainder;
+        int64_t stepColumn, stepRemainder;
+        int64_t divisor;
+        int rowStart, rowEnd;  // Rows [rowStart, rowEnd) whose pixel centers it spans
+        int winding;           // +1 going down, -1 going up
+    };
+    std::vector<PolygonEdge> polygonEdges_;  // fillPolygon edge table, reused across calls
+    std::vector<uint32_t> activeEdges_;      // Edges crossing the current row, by column
     Vec2 position_{0.0f, 0.0f};
     float scale_ = 1.0f;
     bool visible_ = true;
@@ -119,11 +376,80 @@ private:
 
     // OpenGL shader path
     unsigned int glIndexTexture_ = 0;   // R8 texture with indices
-    unsigned int glPaletteTexture_ = 0; // 256x1 RGBA texture with palette
+    unsigned int glPaletteTexture_ = 0; // 256 x kMaxPaletteBanks RGBA texture with the palette banks
+    unsigned int glScanlineTexture_ = 0; // 1 x height RGBA16I texture with the scanline effects
     bool pixelsDirty_ = true;           // Pixels need upload to GL
     bool paletteDirty_ = true;          // Palette needs upload to GL
+    bool scanlineEffectsDirty_ = false; // Scanline table changed (or was cleared)
+
+    // Dirty rectangle (inclusive, valid while pixelsDirty_; starts as the whole buffer)
+    int dirtyMinX_ = 0, dirtyMinY_ = 0;
+    int dirtyMaxX_ = 0, dirtyMaxY_ = 0;
+
+    // upload(): expand one row through its scanline effect
+    void expandScanline(int y, Color* dest);
+
+    // Fixed-point triangle fill (coordinates in 1/16 pixel)
+    void rasterizeTriangle(int64_t x0, int64_t y0, int64_t x1, int64_t y1,
+                           int64_t x2, int64_t y2, uint8_t paletteIndex, const BlendTable* blend = nullptr);
+
+    // Scanline polygon fill behind both fillPolygon overloads
+    void rasterizePolygon(const Vec2* points, size_t count, uint8_t paletteIndex, FillRule rule,
+                          const BlendTable* blend);
+
+    // Whole buffer stale (swap, double-buffering changes)
+    void markAllPixelsDirty();
+
+    // Single-pixel fast path for setPixel (x, y already bounds-checked)
+    void markPixelDirty(int x, int y) {
+        if (doubleBuffered_) {
+            return;
+        }
+        if (!pixelsDirty_) {
+            dirtyMinX_ = dirtyMaxX_ = x;
+            dirtyMinY_ = dirtyMaxY_ = y;
+            pixelsDirty_ = true;
+        } else {
+            dirtyMinX_ = std::min(dirtyMinX_, x);
+            dirtyMinY_ = std::min(dirtyMinY_, y);
+            dirtyMaxX_ = std::max(dirtyMaxX_, x);
+            dirtyMaxY_ = std::max(dirtyMaxY_, y);
+        }
+        dirty_ = true;
+    }
 };
 
+template <typename Kernel>
+void IndexedPixelBuffer::parallelForRows(Kernel&& kernel) {
+    uint8_t* pixels = pixels_.data();
+    int pitch = width_;
+    WorkerPool::getInstance().parallelForBands(height_, static_cast<size_t>(width_), [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            kernel(y, pixels + static_cast<ptrdiff_t>(y) * pitch);
+        }
+    });
+    markPixelsDirty();
+}
+
+template <typename Kernel>
+void IndexedPixelBuffer::parallelForRowsFromPrevious(Kernel&& kernel) {
+    uint8_t* next = pixels_.data();
+    ConstRowView<uint8_t> previous = getFrontPixels();
+    if (!doubleBuffered_) {
+        nextPixels_.resize(pixels_.size());  // Allocates on the first call only
+        next = nextPixels_.data();
+    }
+    WorkerPool::getInstance().parallelForBands(height_, static_cast<size_t>(width_) * 2, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            kernel(y, next + static_cast<ptrdiff_t>(y) * previous.pitch, previous);
+        }
+    });
+    if (!doubleBuffered_) {
+        pixels_.swap(nextPixels_);
+        markPixelsDirty();
+    }
+}
+
 using IndexedPixelBufferPtr = std::shared_ptr<IndexedPixelBuffer>;
 
 } // namespace Engine
@@ -5,9 +5,25 @@
 #include <fstream>
 #include <sstream>
 #include <memory>
+#include <atomic>
 #include <chrono>
-#include <iomanip>
-#include <ctime>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+// Log calls below this level are compiled out (0 = Debug, 1 = Info,
+// 2 = Warning, 3 = Error). Release builds (NDEBUG) drop LOG_DEBUG* by default;
+// define ENGINE_LOG_MIN_LEVEL (CMake: -DENGINE_LOG_MIN_LEVEL=<n>) to override.
+#ifndef ENGINE_LOG_MIN_LEVEL
+    #ifdef NDEBUG
+        #define ENGINE_LOG_MIN_LEVEL 1
+    #else
+        #define ENGINE_LOG_MIN_LEVEL 0
+    #endif
+#endif
 
 namespace Engine {
 
@@ -20,6 +36,7 @@ enum class LogLevel {
 };
 
 // Log output destination
+// Logger calls write() and flush() from one thread at a time
 class LogOutput {
 public:
     virtual ~LogOutput() = default;
@@ -33,7 +50,7 @@ public:
     explicit ConsoleOutput(std::ostream& stream = std::cout) : stream_(stream) {}
 
     void write(const std::string& message) override {
-        stream_ << message << std::endl;
+        stream_ << message << '\n';
     }
 
     void flush() override {
@@ -56,7 +73,7 @@ public:
 
     void write(const std::string& message) override {
         if (file_.is_open()) {
-            file_ << message << std::endl;
+            file_ << message << '\n';
         }
     }
 
@@ -71,20 +88,33 @@ private:
 };
 
 // Logger singleton
+// Thread-safe: any thread may log. In synchronous mode (default) each record is
+// formatted, written and flushed on the calling thread under a mutex. In
+// asynchronous mode producers copy the raw record into a lock-free MPSC ring
+// buffer and a background thread formats and writes records in batches with
+// one flush per batch. When the ring is full new records are dropped (and
+// counted) rather than blocking the caller.
 class Logger {
 public:
+    // Longest message kept in async mode; longer messages are truncated
+    static constexpr size_t kMaxAsyncMessageLength = 448;
+
     static Logger& getInstance() {
         static Logger instance;
         return instance;
     }
 
-    // Configure logger
-    void setOutput(std::unique_ptr<LogOutput> output) {
-        output_ = std::move(output);
-    }
+    // Configure logger (call from the main thread)
+    void setOutput(std::unique_ptr<LogOutput> output);
 
     void setMinLevel(LogLevel level) {
-        minLevel_ = level;
+        minLevel_.store(level, std::memory_order_relaxed);
+    }
+    LogLevel getMinLevel() const { return minLevel_.load(std::memory_order_relaxed); }
+
+    // Runtime level check (the macros also apply ENGINE_LOG_MIN_LEVEL at compile time)
+    bool shouldLog(LogLevel level) const {
+        return level >= minLevel_.load(std::memory_order_relaxed);
     }
 
     void setShowTimestamp(bool show) { showTimestamp_ = show; }
@@ -93,196 +123,163 @@ public:
     void setShowLevel(bool show) { showLevel_ = show; }
 
     // Frame tracking
-    void setFrameNumber(uint64_t frame) { frameNumber_ = frame; }
-    uint64_t getFrameNumber() const { return frameNumber_; }
-
-    // Logging methods
-    void log(LogLevel level, const std::string& message,
-             const char* file = nullptr, int line = -1) {
-        if (level < minLevel_) return;
-        if (!output_) return;
-
-        std::ostringstream oss;
-
-        // Timestamp (time since logger creation)
-        if (showTimestamp_) {
-            auto now = std::chrono::steady_clock::now();
-            auto elapsed = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now - startTime_).count();
-            oss << "[" << std::setw(8) << std::setfill(' ') << elapsed << "ms] ";
-        }
-
-        // Wall clock time
-        if (showWallClock_) {
-            auto now = std::chrono::system_clock::now();
-            auto time = std::chrono::system_clock::to_time_t(now);
-            auto ms = std::chrono::duration_cast<std::chrono::milliseconds>(
-                now.time_since_epoch()) % 1000;
-
-            std::tm tm;
-            #ifdef _WIN32
-                localtime_s(&tm, &time);
-            #else
-                localtime_r(&time, &tm);
-            #endif
-
-            oss << "[" << std::put_time(&tm, "%H:%M:%S")
-                << "." << std::setw(3) << std::setfill('0') << ms.count() << "] ";
-        }
+    void setFrameNumber(uint64_t frame) { frameNumber_.store(frame, std::memory_order_relaxed); }
+    uint64_t getFrameNumber() const { return frameNumber_.load(std::memory_order_relaxed); }
 
-        // Frame number
-        if (showFrame_) {
-            oss << "[F:" << std::setw(6) << std::setfill(' ') << frameNumber_ << "] ";
-        }
+    // Asynchronous mode
+    // capacity: ring buffer slots (rounded up to a power of two)
+    void setAsync(bool async, size_t capacity = 4096);
+    bool isAsync() const { return async_.load(std::memory_order_acquire); }
 
-        // Log level
-        if (showLevel_) {
-            oss << "[" << levelToString(level) << "] ";
-        }
+    // Records dropped because the async ring buffer was full
+    uint64_t getDroppedCount() const { return dropped_.load(std::memory_order_relaxed); }
 
-        // File and line (if provided)
-        if (file && line >= 0) {
-            // Extract just filename from path
-            const char* filename = file;
-            const char* lastSlash = file;
-            while (*lastSlash) {
-                if (*lastSlash == '/' || *lastSlash == '\\') {
-                    filename = lastSlash + 1;
-                }
-                lastSlash++;
-            }
-            oss << "[" << filename << ":" << line << "] ";
-        }
+    // Logging methods
+    void log(LogLevel level, const char* message, size_t length,
+             const char* file = nullptr, int line = -1);
 
-        // Message
-        oss << message;
+    void log(LogLevel level, const std::string& message,
+             const char* file = nullptr, int line = -1) {
+        log(level, message.data(), message.size(), file, line);
+    }
 
-        output_->write(oss.str());
+    void log(LogLevel level, const char* message,
+             const char* file = nullptr, int line = -1) {
+        log(level, message, std::char_traits<char>::length(message), file, line);
     }
 
-    void debug(const std::string& message, const char* file = nullptr, int line = -1) {
+    template<typename Message>
+    void debug(const Message& message, const char* file = nullptr, int line = -1) {
         log(LogLevel::Debug, message, file, line);
     }
 
-    void info(const std::string& message, const char* file = nullptr, int line = -1) {
+    template<typename Message>
+    void info(const Message& message, const char* file = nullptr, int line = -1) {
         log(LogLevel::Info, message, file, line);
     }
 
-    void warning(const std::string& message, const char* file = nullptr, int line = -1) {
+    template<typename Message>
+    void warning(const Message& message, const char* file = nullptr, int line = -1) {
         log(LogLevel::Warning, message, file, line);
     }
 
-    void error(const std::string& message, const char* file = nullptr, int line = -1) {
+    template<typename Message>
+    void error(const Message& message, const char* file = nullptr, int line = -1) {
         log(LogLevel::Error, message, file, line);
     }
 
-    void flush() {
-        if (output_) {
-            output_->flush();
-        }
-    }
+    // Write everything logged so far (in async mode, waits for the background thread)
+    void flush();
 
 private:
-    Logger()
-        : output_(std::make_unique<ConsoleOutput>())
-        , minLevel_(LogLevel::Info)
-        , showTimestamp_(true)
-        , showWallClock_(true)
-        , showFrame_(true)
-        , showLevel_(true)
-        , frameNumber_(0)
-        , startTime_(std::chrono::steady_clock::now()) {
-    }
-
-    const char* levelToString(LogLevel level) {
-        switch (level) {
-            case LogLevel::Debug:   return "DEBUG";
-            case LogLevel::Info:    return "INFO ";
-            case LogLevel::Warning: return "WARN ";
-            case LogLevel::Error:   return "ERROR";
-        }
-        return "UNKNOWN";
-    }
+    // One ring buffer slot - the record as captured on the producer thread
+    struct Record {
+        std::atomic<uint64_t> sequence{0};  // Vyukov bounded queue turn counter
+        LogLevel level = LogLevel::Info;
+        uint32_t length = 0;
+        int line = -1;
+        const char* file = nullptr;         // __FILE__, static storage
+        uint64_t frame = 0;
+        int64_t steadyMs = 0;               // Since logger creation
+        int64_t wallMs = 0;                 // Since the Unix epoch
+        char message[kMaxAsyncMessageLength];
+    };
+
+    Logger();
+    ~Logger();
+    Logger(const Logger&) = delete;
+    Logger& operator=(const Logger&) = delete;
+
+    // Fill in everything but the message text and sequence
+    void capture(Record& record, LogLevel level, size_t length, const char* file, int line) const;
+    bool tryPush(LogLevel level, const char* message, size_t length, const char* file, int line);
+    size_t drain();          // Consumer: format and write all published records
+    void consumerLoop();
+    void stopAsync();
+
+    // Format one record into formatted_ (callers hold outputMutex_)
+    void formatRecord(const Record& record, const char* message, size_t length);
+
+    static const char* levelToString(LogLevel level);
 
     std::unique_ptr<LogOutput> output_;
-    LogLevel minLevel_;
+    std::atomic<LogLevel> minLevel_;
     bool showTimestamp_;
     bool showWallClock_;
     bool showFrame_;
     bool showLevel_;
-    uint64_t frameNumber_;
+    std::atomic<uint64_t> frameNumber_;
     std::chrono::steady_clock::time_point startTime_;
+
+    // Output and formatting state (only touched under outputMutex_)
+    std::mutex outputMutex_;
+    std::string formatted_;
+    int64_t cachedWallSecond_ = -1;  // localtime_r is only called once per second
+    char cachedWallClock_[16] = {};
+
+    // Async ring buffer
+    std::vector<Record> ring_;
+    uint64_t ringMask_ = 0;
+    std::atomic<uint64_t> enqueuePos_{0};
+    uint64_t dequeuePos_ = 0;                // Consumer thread only
+    std::atomic<uint64_t> processed_{0};     // Records written by the consumer
+    std::atomic<uint64_t> dropped_{0};
+    std::atomic<bool> async_{false};
+    std::atomic<uint32_t> activeProducers_{0};  // log() calls that may still touch ring_
+    std::atomic<bool> stopRequested_{false};
+    std::thread consumer_;
+    std::mutex wakeMutex_;
+    std::condition_variable wakeCondition_;
 };
 
 } // namespace Engine
 
-// Convenient logging macros (use ::Engine::Logger for global scope)
-#define LOG_DEBUG(msg) \
-    ::Engine::Logger::getInstance().debug(msg, __FILE__, __LINE__)
-
-#define LOG_INFO(msg) \
-    ::Engine::Logger::getInstance().info(msg, __FILE__, __LINE__)
+// Level gate for the macros: constant-false below ENGINE_LOG_MIN_LEVEL, so the
+// whole call (including message formatting) is removed by the compiler
+#define ENGINE_LOG_ENABLED(level) \
+    (static_cast<int>(level) >= ENGINE_LOG_MIN_LEVEL && \
+     ::Engine::Logger::getInstance().shouldLog(level))
 
-#define LOG_WARNING(msg) \
-    ::Engine::Logger::getInstance().warning(msg, __FILE__, __LINE__)
-
-#define LOG_ERROR(msg) \
-    ::Engine::Logger::getInstance().error(msg, __FILE__, __LINE__)
-
-// Stream-style macros for easier formatting
-#define LOG_DEBUG_STREAM(stream) \
+// Convenient logging macros (use ::Engine::Logger for global scope)
+#define ENGINE_LOG(level, msg) \
     do { \
-        std::ostringstream oss; \
-        oss << stream; \
-        ::Engine::Logger::getInstance().debug(oss.str(), __FILE__, __LINE__); \
+        if (ENGINE_LOG_ENABLED(level)) \
+            ::Engine::Logger::getInstance().log(level, msg, __FILE__, __LINE__); \
     } while(0)
 
-#define LOG_INFO_STREAM(stream) \
-    do { \
-        std::ostringstream oss; \
-        oss << stream; \
-        ::Engine::Logger::getInstance().info(oss.str(), __FILE__, __LINE__); \
-    } while(0)
+#define LOG_DEBUG(msg)   ENGINE_LOG(::Engine::LogLevel::Debug, msg)
+#define LOG_INFO(msg)    ENGINE_LOG(::Engine::LogLevel::Info, msg)
+#define LOG_WARNING(msg) ENGINE_LOG(::Engine::LogLevel::Warning, msg)
+#define LOG_ERROR(msg)   ENGINE_LOG(::Engine::LogLevel::Error, msg)
 
-#define LOG_WARNING_STREAM(stream) \
+// Stream-style macros for easier formatting
+#define ENGINE_LOG_STREAM(level, stream) \
     do { \
-        std::ostringstream oss; \
-        oss << stream; \
-        ::Engine::Logger::getInstance().warning(oss.str(), __FILE__, __LINE__); \
+        if (ENGINE_LOG_ENABLED(level)) { \
+            std::ostringstream oss; \
+            oss << stream; \
+            ::Engine::Logger::getInstance().log(level, oss.str(), __FILE__, __LINE__); \
+        } \
     } while(0)
 
-#define LOG_ERROR_STREAM(stream) \
-    do { \
-        std::ostringstream oss; \
-        oss << stream; \
-        ::Engine::Logger::getInstance().error(oss.str(), __FILE__, __LINE__); \
-    } while(0)
+#define LOG_DEBUG_STREAM(stream)   ENGINE_LOG_STREAM(::Engine::LogLevel::Debug, stream)
+#define LOG_INFO_STREAM(stream)    ENGINE_LOG_STREAM(::Engine::LogLevel::Info, stream)
+#define LOG_WARNING_STREAM(stream) ENGINE_LOG_STREAM(::Engine::LogLevel::Warning, stream)
+#define LOG_ERROR_STREAM(stream)   ENGINE_LOG_STREAM(::Engine::LogLevel::Error, stream)
 
 // Printf-style macros for easier formatting with format strings
-#define LOG_DEBUG_FMT(fmt, ...) \
-    do { \
-        char buffer[1024]; \
-        std::snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-        ::Engine::Logger::getInstance().debug(buffer, __FILE__, __LINE__); \
-    } while(0)
-
-#define LOG_INFO_FMT(fmt, ...) \
+#define ENGINE_LOG_FMT(level, fmt, ...) \
     do { \
-        char buffer[1024]; \
-        std::snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-        ::Engine::Logger::getInstance().info(buffer, __FILE__, __LINE__); \
+        if (ENGINE_LOG_ENABLED(level)) { \
+            char buffer[1024]; \
+            int length = std::snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
+            if (length >= static_cast<int>(sizeof(buffer))) length = sizeof(buffer) - 1; \
+            if (length >= 0) \
+                ::Engine::Logger::getInstance().log(level, buffer, static_cast<size_t>(length), __FILE__, __LINE__); \
+        } \
     } while(0)
 
-#define LOG_WARNING_FMT(fmt, ...) \
-    do { \
-        char buffer[1024]; \
-        std::snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-        ::Engine::Logger::getInstance().warning(buffer, __FILE__, __LINE__); \
-    } while(0)
-
-#define LOG_ERROR_FMT(fmt, ...) \
-    do { \
-        char buffer[1024]; \
-        std::snprintf(buffer, sizeof(buffer), fmt, ##__VA_ARGS__); \
-        ::Engine::Logger::getInstance().error(buffer, __FILE__, __LINE__); \
-    } while(0)
+#define LOG_DEBUG_FMT(fmt, ...)   ENGINE_LOG_FMT(::Engine::LogLevel::Debug, fmt, ##__VA_ARGS__)
+#define LOG_INFO_FMT(fmt, ...)    ENGINE_LOG_FMT(::Engine::LogLevel::Info, fmt, ##__VA_ARGS__)
+#define LOG_WARNING_FMT(fmt, ...) ENGINE_LOG_FMT(::Engine::LogLevel::Warning, fmt, ##__VA_ARGS__)
+#define LOG_ERROR_FMT(fmt, ...)   ENGINE_LOG_FMT(::Engine::LogLevel::Error, fmt, ##__VA_ARGS__)
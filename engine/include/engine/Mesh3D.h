@@ -11,6 +11,7 @@ namespace Engine {
 // Forward declarations
 class Sprite;
 class IndexedPixelBuffer;
+class ShadeTable;
 
 // Anchor mode for 3D meshes
 enum class MeshAnchorMode {
@@ -151,6 +152,13 @@ public:
     void setRenderMode(MeshRenderMode mode) { renderMode_ = mode; }
     MeshRenderMode getRenderMode() const { return renderMode_; }
 
+    // Lighting through a shade table: each face's color is shaded to the level
+    // matching its light intensity (full intensity = the top level). Without a
+    // table, faces use the built-in palette layout - color, color + 7 and
+    // color + 14 for bright, medium and dark faces.
+    void setShadeTable(std::shared_ptr<const ShadeTable> shades) { shadeTable_ = std::move(shades); }
+    const std::shared_ptr<const ShadeTable>& getShadeTable() const { return shadeTable_; }
+
     // Anchoring - attach mesh to viewport or sprite
     void setAnchorMode(MeshAnchorMode mode) { anchorMode_ = mode; }
     MeshAnchorMode getAnchorMode() const { return anchorMode_; }
@@ -193,12 +201,29 @@ private:
     bool visible_ = true;
     bool backFaceCulling_ = true;
     MeshRenderMode renderMode_ = MeshRenderMode::Filled;
+    std::shared_ptr<const ShadeTable> shadeTable_;
 
     // Anchoring
     MeshAnchorMode anchorMode_ = MeshAnchorMode::Viewport;
     std::weak_ptr<Sprite> anchoredSprite_;
     AnchorPoint spriteAnchor_ = AnchorPoint::Center;
     Vec2 anchorOffset_{0.0f, 0.0f};
+
+    // renderToBuffer scratch - keeps steady-state frames free of heap allocations
+    mutable std::vector<Vec3> transformedScratch_;
+    mutable std::vector<Vec3> normalScratch_;
+    mutable std::vector<Vec2> projectedScratch_;
+    mutable std::vector<Vec2> outlineScratch_;
+
+    // Wireframe edges, keyed by (lower, higher) vertex index for deduplication
+    struct WireEdge {
+        uint64_t key;
+        uint8_t color;
+        bool duplicate;
+    };
+    mutable std::vector<WireEdge> edgeScratch_;
+    mutable std::vector<uint32_t> edgeOrderScratch_;
+    mutable std::vector<Vec2> segmentScratch_;
 };
 
 using Mesh3DPtr = std::shared_ptr<Mesh3D>;
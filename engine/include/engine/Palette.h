@@ -1,9 +1,13 @@
 #pragma once
 
 #include "Types.h"
+#include "BlendTable.h"
 #include <array>
+#include <cstddef>
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <vector>
 
 namespace Engine {
 
@@ -21,11 +25,26 @@ public:
 
     // Get/Set palette data
     const std::array<Color, 256>& getColors() const { return colors_; }
-    void setColors(const std::array<Color, 256>& colors) { colors_ = colors; }
+    // Setting the colors a palette already has keeps its cached tables
+    void setColors(const std::array<Color, 256>& colors);
 
     // Get individual color
     const Color& getColor(uint8_t index) const { return colors_[index]; }
-    void setColor(uint8_t index, const Color& color) { colors_[index] = color; }
+    void setColor(uint8_t index, const Color& color);
+
+    // Nearest entry to a color: smallest squared RGB distance, alpha ignored, ties
+    // to the lowest index (the same result as scanning all 256 entries).
+    // Both lookups use an inverse table built on first use (10-20 ms) and dropped
+    // when a color changes. Safe to call from several threads while the colors stay
+    // unchanged.
+    // findNearest is exact: it only tests the entries that can be nearest for the
+    // color's 16x16x16 cell. findNearestFast is one load from a 32K-entry RGB555
+    // table holding the entry nearest to the center of each 8x8x8 cell.
+    uint8_t findNearest(const Color& color) const;
+    uint8_t findNearestFast(const Color& color) const;
+
+    // Bulk RGBA -> index conversion of count pixels
+    void mapColors(const Color* src, uint8_t* dest, size_t count, bool exact = true) const;
 
     // Generate standard palettes
     static Palette createGrayscale();
@@ -33,8 +52,42 @@ public:
     static Palette createFireGradient();
     static Palette createRainbow();
 
+    // Generate an optimized palette for an RGBA image (rows pitch pixels apart)
+    // Pixels are counted into a 5-5-5 RGB histogram (in parallel row bands on the
+    // WorkerPool), then the occupied buckets are split by weighted median cut -
+    // always the box with the largest color variance, at the pixel-count median of
+    // its widest axis - into up to colorCount boxes. Each entry is the mean color
+    // (alpha included) of its box's pixels; unused entries are opaque black.
+    static Palette createOptimized(const Color* pixels, int width, int height, int pitch,
+                                   int colorCount = 256);
+
+    // Inverse table behind findNearest/findNearestFast (built on first call)
+    struct InverseTable {
+        static constexpr int kCellBits = 4;  // Exact lookup: 16x16x16-color cells
+        std::array<uint32_t, (1 << (3 * kCellBits)) + 1> cellStart;  // Offsets into candidates
+        std::vector<uint8_t> candidates;    // Per cell, ascending palette indices
+        std::array<uint8_t, 1 << 15> nearest555;  // findNearestFast
+
+        uint8_t findNearest(const Color& color, const Color* palette) const;
+        uint8_t findNearestFast(const Color& color) const {
+            return nearest555[((color.r >> 3) << 10) | ((color.g >> 3) << 5) | (color.b >> 3)];
+        }
+    };
+    std::shared_ptr<const InverseTable> getInverseTable() const;
+
+    // Translucency table for these colors (see BlendTable), built on first request
+    // and cached until a color changes. Tables are shared by content: every palette
+    // holding the same colors (e.g. each buffer given one palette) gets the same
+    // table while any of them still caches it. Animated palettes should hold on to
+    // a table from BlendTable::create instead of rebuilding it.
+    std::shared_ptr<const BlendTable> getBlendTable(BlendMode mode, uint8_t alpha = 128) const;
+
 private:
+    void invalidateCaches();
+
     std::array<Color, 256> colors_;
+    mutable std::shared_ptr<const InverseTable> inverse_;  // Lazily built, reset on color changes
+    mutable std::vector<std::shared_ptr<const BlendTable>> blendTables_;  // Guarded by the blend cache mutex in Palette.cpp
 };
 
 using PalettePtr = std::shared_ptr<Palette>;
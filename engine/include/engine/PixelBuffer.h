@@ -4,6 +4,7 @@
 #include "Texture.h"
 #include "PixelFont.h"
 #include "ILayerAttachable.h"
+#include "WorkerPool.h"
 #include <vector>
 #include <memory>
 #include <string>
@@ -12,6 +13,19 @@ namespace Engine {
 
 class IRenderer;
 
+// How PixelBuffer::blit combines source pixels with the destination
+enum class PixelBlend : uint8_t {
+    Copy,     // dest = src
+    Alpha,    // src over dest: dest.rgb = src.rgb * src.a + dest.rgb * (1 - src.a)
+    Additive  // dest.rgb += src.rgb * src.a, saturating
+};
+
+// Options for PixelBuffer::blit
+struct PixelBlitOptions {
+    PixelBlend blend = PixelBlend::Alpha;
+    bool premultiplied = false;  // Source rgb is already multiplied by its alpha
+};
+
 // A bitmap buffer for direct pixel manipulation
 // Perfect for debug drawing, effects, minimaps, or retro "chunky pixel" graphics
 // Pixels are manipulated in RAM and uploaded to GPU as needed
@@ -28,6 +42,32 @@ public:
     void clear(const Color& color = Color{0, 0, 0, 0}); // Clear to transparent black by default
     void fill(const Color& color);  // Same as clear, for consistency
 
+    // Parallel row kernels (see IndexedPixelBuffer::parallelForRows): kernel(y, row)
+    // runs in cache-sized bands on the WorkerPool threads and writes only its own row;
+    // the buffer is marked dirty once at the end
+    template <typename Kernel>
+    void parallelForRows(Kernel&& kernel);
+    // kernel(y, row, previous) reads the previous frame (a ConstRowView<Color>) and
+    // writes every pixel of row; the pixel arrays are swapped afterwards, so pointers
+    // from getPixelData() taken before the call go stale
+    template <typename Kernel>
+    void parallelForRowsFromPrevious(Kernel&& kernel);
+
+    // RGBA blitter: composite a source rectangle at (destX, destY), clipped
+    // against both buffers. Alpha and Additive rows run through the SIMD kernels
+    // in PixelKernels (8 pixels per AVX2 step); both produce
+    // dest.a = src.a + dest.a * (1 - src.a). Blitting a buffer onto itself is allowed.
+    void blit(const PixelBuffer& source, int srcX, int srcY, int width, int height,
+              int destX, int destY, const PixelBlitOptions& options = PixelBlitOptions());
+    void blit(const PixelBuffer& source, int destX, int destY,
+              const PixelBlitOptions& options = PixelBlitOptions()) {
+        blit(source, 0, 0, source.width_, source.height_, destX, destY, options);
+    }
+    // Raw pixels (pitch in pixels), e.g. decals kept outside a PixelBuffer;
+    // they must not point into this buffer
+    void blit(const Color* pixels, int width, int height, int pitch, int destX, int destY,
+              const PixelBlitOptions& options = PixelBlitOptions());
+
     // Load image file into the buffer at specified position
     // Returns true on success, false on failure
     bool loadFromFile(const std::string& imagePath, int destX = 0, int destY = 0);
@@ -67,17 +107,52 @@ public:
     void markDirty() { dirty_ = true; }
     void markClean() { dirty_ = false; }
 
+    // Direct access to pixel data (for CPU compositing)
+    const Color* getPixelData() const { return pixels_.data(); }
+
 private:
     int width_;
     int height_;
     std::vector<Color> pixels_;  // width * height colors (row-major: y * width + x)
+    std::vector<Color> nextPixels_;  // parallelForRowsFromPrevious() target, swapped with pixels_
+    std::vector<Color> blitScratch_;  // Source copy for blits within this buffer
     TexturePtr texture_;
     Vec2 position_{0.0f, 0.0f};
     float scale_ = 1.0f;
     bool visible_ = true;
     bool dirty_ = true;  // Need to re-upload to GPU?
+
+    // Composites an already clipped rectangle (src and dest must not overlap)
+    void blitRows(const Color* src, ptrdiff_t srcPitch, int destX, int destY, int width, int height,
+                  const PixelBlitOptions& options);
 };
 
+template <typename Kernel>
+void PixelBuffer::parallelForRows(Kernel&& kernel) {
+    Color* pixels = pixels_.data();
+    int pitch = width_;
+    WorkerPool::getInstance().parallelForBands(height_, sizeof(Color) * width_, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            kernel(y, pixels + static_cast<ptrdiff_t>(y) * pitch);
+        }
+    });
+    dirty_ = true;
+}
+
+template <typename Kernel>
+void PixelBuffer::parallelForRowsFromPrevious(Kernel&& kernel) {
+    nextPixels_.resize(pixels_.size());  // Allocates on the first call only
+    Color* next = nextPixels_.data();
+    ConstRowView<Color> previous{pixels_.data(), width_, height_, width_};
+    WorkerPool::getInstance().parallelForBands(height_, sizeof(Color) * width_ * 2, [&](int begin, int end) {
+        for (int y = begin; y < end; ++y) {
+            kernel(y, next + static_cast<ptrdiff_t>(y) * previous.pitch, previous);
+        }
+    });
+    pixels_.swap(nextPixels_);
+    dirty_ = true;
+}
+
 using PixelBufferPtr = std::shared_ptr<PixelBuffer>;
 
 } // namespace Engine
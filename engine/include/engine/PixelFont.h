@@ -69,6 +69,9 @@ public:
     // Get character count
     int getCharCount() const { return static_cast<int>(glyphs_.size()); }
 
+    // Bytes held by glyph pixels and bitmasks
+    size_t getMemoryUsage() const;
+
 private:
     int charWidth_ = 0;
     int charHeight_ = 0;
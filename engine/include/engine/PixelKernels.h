@@ -0,0 +1,49 @@
+#pragma once
+
+#include "Types.h"
+#include <cstddef>
+#include <cstdint>
+
+namespace Engine {
+
+// Instruction set used by the pixel kernels, detected once at runtime
+enum class SimdLevel {
+    Scalar,
+    AVX2
+};
+
+SimdLevel getSimdLevel();
+const char* toString(SimdLevel level);
+
+// Palette expansion: dest[i] = palette[indices[i]] for count pixels
+// palette must hold 256 entries. Dispatches to the widest kernel the CPU
+// supports (AVX2 gathers eight palette entries per instruction).
+void expandIndexed(const uint8_t* indices, const Color* palette, Color* dest, size_t count);
+
+// Portable reference kernel (also the fallback on non-x86 targets)
+void expandIndexedScalar(const uint8_t* indices, const Color* palette, Color* dest, size_t count);
+
+// Masked index copy: dest[i] = src[i] wherever src[i] != transparentIndex
+// Compares and blends 32 (AVX2) or 16 (SSE2) pixels per step. src and dest must not overlap.
+void blitMaskedIndexed(const uint8_t* src, uint8_t* dest, size_t count, uint8_t transparentIndex);
+void blitMaskedIndexedScalar(const uint8_t* src, uint8_t* dest, size_t count, uint8_t transparentIndex);
+
+// Light-map shading: pixels[i] = table[light[i] << 8 | pixels[i]] for count pixels
+// table holds 256 x 256 entries plus kShadeTablePadding readable bytes after them
+// (the AVX2 kernel gathers 32-bit words and keeps the low byte, 8 pixels per gather).
+constexpr size_t kShadeTablePadding = 3;
+void shadeIndexed(uint8_t* pixels, const uint8_t* light, const uint8_t* table, size_t count);
+void shadeIndexedScalar(uint8_t* pixels, const uint8_t* light, const uint8_t* table, size_t count);
+
+// RGBA compositing: src over dest ("Over") or added onto dest ("Add") for count
+// pixels. Straight-alpha sources are weighted by their alpha first; premultiplied
+// sources are used as they are. Both write dest.a = src.a + dest.a * (1 - src.a).
+// Channel products are rounded x / 255 and sums saturate, identically in every
+// kernel. AVX2 blends 8 pixels per step, SSE2 4; runs that are fully transparent
+// or (for Over) fully opaque skip the arithmetic. src and dest must not overlap.
+void blendOverRGBA(const Color* src, Color* dest, size_t count, bool premultiplied);
+void blendOverRGBAScalar(const Color* src, Color* dest, size_t count, bool premultiplied);
+void blendAddRGBA(const Color* src, Color* dest, size_t count, bool premultiplied);
+void blendAddRGBAScalar(const Color* src, Color* dest, size_t count, bool premultiplied);
+
+} // namespace Engine
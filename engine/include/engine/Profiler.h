@@ -0,0 +1,147 @@
+#pragma once
+
+#include "AllocationTracker.h"
+#include <atomic>
+#include <cstdint>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Profiling zones are compiled in for debug builds and compiled out for release
+// builds (NDEBUG). Define ENGINE_PROFILER_ENABLED=1 (CMake: -DENGINE_ENABLE_PROFILER=ON)
+// to keep them in optimized builds, or =0 to strip them everywhere.
+#ifndef ENGINE_PROFILER_ENABLED
+    #ifdef NDEBUG
+        #define ENGINE_PROFILER_ENABLED 0
+    #else
+        #define ENGINE_PROFILER_ENABLED 1
+    #endif
+#endif
+
+namespace Engine {
+
+// Low-overhead frame profiler
+// Scoped zones record (name, start, end) nanosecond timestamps into a fixed-size
+// ring buffer owned by the recording thread - no locks or allocations on the hot
+// path. Recording is off until setEnabled(true); a disabled zone costs one
+// relaxed atomic load. Traces export to the Chrome/Perfetto JSON format
+// (open in chrome://tracing or https://ui.perfetto.dev).
+class Profiler {
+public:
+    // A completed zone (or an instant marker when startNs == endNs)
+    struct Event {
+        const char* name = nullptr;  // Must point to static storage (string literal)
+        uint64_t startNs = 0;
+        uint64_t endNs = 0;
+    };
+
+    // Events kept per thread before the oldest are overwritten (power of two)
+    static constexpr size_t kEventsPerThread = 1 << 16;
+
+    static Profiler& getInstance() {
+        static Profiler instance;
+        return instance;
+    }
+
+    // Runtime switch (zones compiled in but disabled are nearly free)
+    void setEnabled(bool enabled) { enabled_.store(enabled, std::memory_order_relaxed); }
+    bool isEnabled() const { return enabled_.load(std::memory_order_relaxed); }
+
+    // Monotonic timestamp in nanoseconds
+    static uint64_t nowNs();
+
+    // Record a completed zone on the calling thread
+    void recordZone(const char* name, uint64_t startNs, uint64_t endNs);
+
+    // Record an instant marker (e.g. frame boundaries) on the calling thread
+    void recordInstant(const char* name) {
+        uint64_t now = nowNs();
+        recordZone(name, now, now);
+    }
+
+    // Name the calling thread in exported traces (default: "Thread <n>")
+    void setThreadName(const std::string& name);
+
+    // Write all buffered events as Chrome trace JSON
+    // Call while other threads are idle for a consistent snapshot
+    bool writeChromeTrace(const std::string& path) const;
+
+    // Drop all buffered events (thread registrations are kept)
+    void clear();
+
+    // Total events currently buffered across all threads
+    size_t getEventCount() const;
+
+private:
+    Profiler() = default;
+    ~Profiler() = default;
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    // Single-producer ring buffer - only the owning thread writes
+    struct ThreadBuffer {
+        std::vector<Event> events;
+        std::atomic<uint64_t> writeIndex{0};
+        uint32_t threadId = 0;
+        std::string name;
+    };
+
+    ThreadBuffer& getThreadBuffer();
+
+    std::atomic<bool> enabled_{false};
+    mutable std::mutex registryMutex_;
+    std::vector<std::unique_ptr<ThreadBuffer>> threads_;  // Outlive their threads
+    uint64_t epochNs_ = nowNs();                          // Trace time origin
+};
+
+// RAII zone - records from construction to destruction
+// With ENGINE_ALLOC_TRACKING, heap allocations inside the zone are attributed to it
+class ProfileZone {
+public:
+    explicit ProfileZone(const char* name)
+        : name_(name)
+        , active_(Profiler::getInstance().isEnabled())
+        , startNs_(active_ ? Profiler::nowNs() : 0)
+#if ENGINE_ALLOC_TRACKING
+        , allocationScope_(name)
+#endif
+    {}
+
+    ~ProfileZone() {
+        if (active_) {
+            Profiler::getInstance().recordZone(name_, startNs_, Profiler::nowNs());
+        }
+    }
+
+    ProfileZone(const ProfileZone&) = delete;
+    ProfileZone& operator=(const ProfileZone&) = delete;
+
+private:
+    const char* name_;
+    bool active_;
+    uint64_t startNs_;
+#if ENGINE_ALLOC_TRACKING
+    AllocationScope allocationScope_;
+#endif
+};
+
+} // namespace Engine
+
+// Convenience macros (zone names must be string literals)
+#if ENGINE_PROFILER_ENABLED
+    #define ENGINE_PROFILE_CONCAT_INNER(a, b) a##b
+    #define ENGINE_PROFILE_CONCAT(a, b) ENGINE_PROFILE_CONCAT_INNER(a, b)
+    #define PROFILE_ZONE(name) ::Engine::ProfileZone ENGINE_PROFILE_CONCAT(profileZone_, __LINE__)(name)
+    #define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+    #define PROFILE_FRAME() \
+        do { \
+            if (::Engine::Profiler::getInstance().isEnabled()) \
+                ::Engine::Profiler::getInstance().recordInstant("Frame"); \
+        } while (0)
+#else
+    // Zones still attribute allocations when only allocation tracking is compiled in
+    #define PROFILE_ZONE(name) ALLOC_SCOPE(name)
+    #define PROFILE_FUNCTION() PROFILE_ZONE(__func__)
+    #define PROFILE_FRAME() do {} while (0)
+#endif
@@ -0,0 +1,71 @@
+#pragma once
+
+#include "Types.h"
+#include "FrameStats.h"
+#include <SDL.h>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace Engine {
+
+struct EngineConfig;
+
+// Deterministic replay/benchmark settings
+// With frames > 0 the engine runs exactly that many frames at a fixed
+// deltaTime with a fixed RNG seed, then stops and writes a JSON report with
+// per-frame timings and a hash of the final framebuffer.
+struct ReplayConfig {
+    int frames = 0;                      // 0 = disabled (normal wall-clock run)
+    float deltaTime = 1.0f / 60.0f;      // Seconds per frame, ignores wall-clock time
+    uint32_t seed = 1;                   // Returned by Engine::getRandomSeed()
+    std::string reportPath = "replay.json";
+
+    bool isEnabled() const { return frames > 0; }
+};
+
+// Parse replay options from the command line into config:
+//   --replay <frames>  --replay-dt <seconds>  --replay-seed <n>
+//   --replay-report <path>  --no-vsync
+// Unknown arguments are ignored; returns false on a malformed value
+bool parseReplayArgs(int argc, char* argv[], EngineConfig& config);
+
+// FNV-1a 64-bit hash of RGBA pixels (byte order r, g, b, a)
+uint64_t hashPixels(const std::vector<Color>& pixels);
+
+// Collects frame timings for a replay run and writes the report
+class ReplayRecorder {
+public:
+    explicit ReplayRecorder(const ReplayConfig& config);
+
+    // Bracket one frame (update + render + present)
+    void beginFrame();
+    void endFrame();
+
+    // True while the frame being recorded is the final one
+    bool isLastFrame() const { return framesRecorded_ + 1 >= config_.frames; }
+    bool isFinished() const { return framesRecorded_ >= config_.frames; }
+
+    // Final framebuffer, captured before the last present()
+    void setFinalFrame(const std::vector<Color>& pixels, int width, int height);
+
+    const FrameStats& getStats() const { return stats_; }
+    const ReplayConfig& getConfig() const { return config_; }
+
+    bool writeReport(const std::string& title, bool vsync) const;
+
+private:
+    ReplayConfig config_;
+    FrameStats stats_;
+    std::vector<float> frameTimes_;  // Every frame in order (ms), reserved up front
+    int framesRecorded_ = 0;
+    Uint64 frameStart_ = 0;
+    double counterToMs_;
+
+    bool hasFinalFrame_ = false;
+    uint64_t finalHash_ = 0;
+    int finalWidth_ = 0;
+    int finalHeight_ = 0;
+};
+
+} // namespace Engine
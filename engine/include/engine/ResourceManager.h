@@ -6,14 +6,58 @@
 #include "Palette.h"
 #include "PixelFont.h"
 #include "Mesh3D.h"
+#include <array>
 #include <string>
 #include <unordered_map>
 #include <memory>
+#include <vector>
 
 namespace Engine {
 
 class IRenderer;
 
+// Resource kinds tracked for memory accounting
+enum class ResourceCategory {
+    Texture,
+    Font,
+    Tilemap,
+    Palette,
+    PixelFont,
+    Mesh,
+    Count
+};
+
+const char* toString(ResourceCategory category);
+
+// Memory held by a resource (or a sum of resources)
+// GPU bytes are estimates: uncompressed RGBA8 for textures, no mipmaps or driver padding
+struct ResourceMemory {
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+
+    size_t total() const { return cpuBytes + gpuBytes; }
+};
+
+// What a load does when it would exceed the budget
+enum class BudgetAction {
+    Warn,  // Log a warning and keep the resource
+    Fail   // Log an error, discard the resource and return nullptr
+};
+
+// Memory budget for all cached resources (0 = unlimited)
+struct MemoryBudget {
+    size_t cpuBytes = 0;
+    size_t gpuBytes = 0;
+    BudgetAction action = BudgetAction::Warn;
+};
+
+// One row of the memory report
+struct ResourceMemoryEntry {
+    ResourceCategory category;
+    std::string name;
+    ResourceMemory memory;
+};
+
 // Centralized resource management with caching
 // Philosophy: Data (Texture, Font) is separate from usage (Sprite, Text)
 class ResourceManager {
@@ -115,9 +159,34 @@ public:
     size_t getPixelFontCount() const { return pixelFonts_.size(); }
     size_t getMeshCount() const { return meshes_.size(); }
 
+    // Memory accounting
+    // Every cached resource is measured when it enters the cache
+    ResourceMemory getResourceMemory(ResourceCategory category, const std::string& name) const;
+    const ResourceMemory& getCategoryMemory(ResourceCategory category) const {
+        return categoryMemory_[static_cast<size_t>(category)];
+    }
+    ResourceMemory getTotalMemory() const;
+
+    // All cached resources, largest first
+    std::vector<ResourceMemoryEntry> getMemoryReport() const;
+    void logMemoryReport(size_t maxEntries = 10) const;
+
+    // Budget checked on every load/create
+    void setMemoryBudget(const MemoryBudget& budget) { budget_ = budget; }
+    const MemoryBudget& getMemoryBudget() const { return budget_; }
+    bool isOverBudget() const;
+
 private:
+    static constexpr size_t kCategoryCount = static_cast<size_t>(ResourceCategory::Count);
+
     std::string makeFullPath(const std::string& relativePath) const;
 
+    // Record a resource entering the cache (replacing any entry with the same name)
+    // Returns false if the budget action is Fail and the resource does not fit
+    bool trackMemory(ResourceCategory category, const std::string& name, const ResourceMemory& memory);
+    void untrackMemory(ResourceCategory category, const std::string& name);
+    void clearMemory(ResourceCategory category);
+
     std::string basePath_;
     IRenderer* renderer_ = nullptr;
 
@@ -127,6 +196,11 @@ private:
     std::unordered_map<std::string, PalettePtr> palettes_;
     std::unordered_map<std::string, PixelFontPtr> pixelFonts_;
     std::unordered_map<std::string, Mesh3DPtr> meshes_;
+
+    // Per-resource sizes and running totals, indexed by ResourceCategory
+    std::array<std::unordered_map<std::string, ResourceMemory>, kCategoryCount> resourceMemory_;
+    std::array<ResourceMemory, kCategoryCount> categoryMemory_{};
+    MemoryBudget budget_;
 };
 
 } // namespace Engine
@@ -33,6 +33,7 @@ public:
 
     TexturePtr createStreamingTexture(int width, int height) override;
     void updateTexture(Texture& texture, const Color* pixels, int width, int height) override;
+    bool updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) override;
 
     void* getBackendContext() override { return renderer_; }
 
@@ -44,7 +45,17 @@ public:
     int getViewportWidth() const override { return windowWidth_; }
     int getViewportHeight() const override { return windowHeight_; }
 
+    bool setVSync(bool enabled) override;
+    bool readPixels(std::vector<Color>& pixels) override;
+
 private:
+    // Every SDL_RenderCopy is one textured quad
+    void countCopy(const void* texture) {
+        ++frameStats_.drawCalls;
+        ++frameStats_.quads;
+        countTextureBind(texture);
+    }
+
     SDL_Window* window_ = nullptr;
     SDL_Renderer* renderer_ = nullptr;
     int windowWidth_ = 0;
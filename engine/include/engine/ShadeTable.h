@@ -0,0 +1,51 @@
+#pragma once
+
+#include "Types.h"
+#include <cstdint>
+#include <memory>
+#include <vector>
+
+namespace Engine {
+
+class Palette;
+
+// Light-level colormaps for indexed pixels (Doom-style shade tables)
+// Level levelCount - 1 leaves colors unchanged; lower levels fade every palette
+// entry towards the fog color (black by default), level 0 being the fog itself,
+// and store the nearest palette entry. Lighting a pixel is one table load instead
+// of an RGB round trip. Tables are immutable snapshots of the palette colors.
+class ShadeTable {
+public:
+    static constexpr int kMaxLevels = 256;
+
+    // levelCount is clamped to [2, kMaxLevels]
+    static std::shared_ptr<const ShadeTable> create(const Palette& palette, int levelCount = 32,
+                                                    const Color& fog = Color{0, 0, 0, 255});
+
+    int getLevelCount() const { return levelCount_; }
+
+    // Palette index for index at a light level (clamped to the valid range)
+    uint8_t shade(uint8_t index, int level) const;
+
+    // 256 entries for one level: usable as BlitOptions::remap to light a sprite
+    const uint8_t* getLevel(int level) const;
+
+    // Index lit by an 8-bit light value (255 = full brightness), which selects
+    // the nearest level
+    uint8_t light(uint8_t index, uint8_t light) const { return byLight_[(light << 8) | index]; }
+
+    // 256 x 256 table [light << 8 | index] (with kShadeTablePadding trailing
+    // bytes) for shadeIndexed and IndexedPixelBuffer::applyLightMap
+    const uint8_t* getLightTable() const { return byLight_.data(); }
+
+private:
+    ShadeTable() = default;
+
+    int levelCount_ = 0;
+    std::vector<uint8_t> levels_;   // levelCount * 256, [level << 8 | index]
+    std::vector<uint8_t> byLight_;  // 256 rows, each a copy of the nearest level
+};
+
+using ShadeTablePtr = std::shared_ptr<const ShadeTable>;
+
+} // namespace Engine
@@ -56,6 +56,7 @@ public:
 
     TexturePtr createStreamingTexture(int width, int height) override;
     void updateTexture(Texture& texture, const Color* pixels, int width, int height) override;
+    bool updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) override;
 
     void* getBackendContext() override { return &device_; }
 
@@ -188,6 +189,16 @@ private:
     bool beginFrame();
     void endFrame();
 
+    // Render statistics helpers (one quad per vkCmdDrawIndexed)
+    void countTextureDescriptor(const void* texture) {
+        ++frameStats_.descriptorBinds;
+        countTextureBind(texture);
+    }
+    void countQuadDraw() {
+        ++frameStats_.drawCalls;
+        ++frameStats_.quads;
+    }
+
     // Shader loading
     VkShaderModule createShaderModule(const std::vector<char>& code);
     std::vector<char> readShaderFile(const std::string& filename);
@@ -206,7 +217,8 @@ private:
     VkImageView createImageView(VkImage image, VkFormat format);
     void transitionImageLayout(VkImage image, VkFormat format,
                               VkImageLayout oldLayout, VkImageLayout newLayout);
-    void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height);
+    void copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height,
+                           int32_t offsetX = 0, int32_t offsetY = 0);
 
     // Texture management
     VulkanTexture* getOrCreateVulkanTexture(Texture* texture);
@@ -0,0 +1,100 @@
+#pragma once
+
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace Engine {
+
+// Fork-join worker pool for data-parallel frame work (row bands of pixel effects)
+// run() hands task indices to the workers and the calling thread, which claim them
+// from a shared atomic counter and return when every index has finished. Dispatch
+// takes no allocations; worker threads are created by setThreadCount() (Engine::init
+// calls it) or lazily on the first run(). Calls made from a worker thread, or while
+// another thread is dispatching, run serially on the caller - nesting is safe.
+class WorkerPool {
+public:
+    using TaskFn = void (*)(void* context, int index);
+    using BandFn = void (*)(void* context, int begin, int end);
+
+    // Band sizing for runBands(): a band covers about this many bytes so each one
+    // stays cache resident, and large jobs are cut into several bands per thread
+    // so threads that finish early can pick up more work
+    static constexpr size_t kTargetBandBytes = 32 * 1024;
+    static constexpr int kBandsPerThread = 4;
+
+    static WorkerPool& getInstance() {
+        static WorkerPool instance;
+        return instance;
+    }
+
+    // Threads used by run(), including the caller (0 = one per hardware thread,
+    // 1 = everything runs on the caller). Call while no job is running.
+    void setThreadCount(int count);
+    int getThreadCount() const;
+
+    // Calls task(context, i) for every i in [0, count); blocks until all are done
+    void run(int count, TaskFn task, void* context);
+
+    // Splits [0, rowCount) into contiguous bands (see kTargetBandBytes) and calls
+    // band(context, begin, end) for each; bytesPerRow is the memory a row touches
+    void runBands(int rowCount, size_t bytesPerRow, BandFn band, void* context);
+
+    // Lambda front ends: fn(i) and fn(begin, end)
+    template <typename Fn>
+    void parallelFor(int count, Fn&& fn) {
+        run(count, [](void* context, int index) { (*static_cast<std::remove_reference_t<Fn>*>(context))(index); }, &fn);
+    }
+    template <typename Fn>
+    void parallelForBands(int rowCount, size_t bytesPerRow, Fn&& fn) {
+        runBands(rowCount, bytesPerRow, [](void* context, int begin, int end) {
+            (*static_cast<std::remove_reference_t<Fn>*>(context))(begin, end);
+        }, &fn);
+    }
+
+private:
+    WorkerPool() = default;
+    ~WorkerPool();
+    WorkerPool(const WorkerPool&) = delete;
+    WorkerPool& operator=(const WorkerPool&) = delete;
+
+    void startWorkers(int threadCount);
+    void stopWorkers();
+    void workerLoop(int workerIndex, uint64_t startGeneration);
+    void drainTasks();
+
+    std::vector<std::thread> workers_;
+    std::atomic<int> threadCount_{0};  // Workers + caller; 0 until the workers are created
+
+    std::mutex dispatchMutex_;  // One job at a time; held by the dispatching thread
+    std::mutex stateMutex_;     // Guards the job description and the counters below
+    std::condition_variable wakeCondition_;
+    std::condition_variable doneCondition_;
+    uint64_t generation_ = 0;   // Bumped per job; workers wake when it changes
+    int pendingWorkers_ = 0;    // Workers that have not finished the current job
+    bool stopRequested_ = false;
+
+    // Current job (written under stateMutex_ before generation_ changes)
+    TaskFn task_ = nullptr;
+    void* context_ = nullptr;
+    int taskCount_ = 0;
+    std::atomic<int> nextTask_{0};
+};
+
+// Read-only rows of a pixel array (e.g. the previous frame in parallelForRowsFromPrevious)
+template <typename T>
+struct ConstRowView {
+    const T* data = nullptr;
+    int width = 0;
+    int height = 0;
+    int pitch = 0;  // Elements between rows
+
+    const T* row(int y) const { return data + static_cast<ptrdiff_t>(y) * pitch; }
+};
+
+} // namespace Engine
@@ -0,0 +1,290 @@
+#include "engine/AllocationTracker.h"
+#include "engine/Logger.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <new>
+
+namespace Engine {
+
+namespace {
+
+// Per-thread state read by the hooks - trivially initialized, never allocates
+thread_local const char* tlsZone = nullptr;
+thread_local int tlsAuditDepth = 0;
+thread_local bool tlsInHook = false;  // Guards against re-entry (e.g. stderr on abort)
+
+const char* const kUnscopedZone = "(unscoped)";
+const char* const kOverflowZone = "(other)";
+
+} // anonymous namespace
+
+// ---------------------------------------------------------------------------
+// Hooks
+// ---------------------------------------------------------------------------
+
+AllocationTracker::ZoneSlot& AllocationTracker::findZone(const char* name) {
+    // Open addressing on the name pointer; slots are claimed once and never freed
+    size_t index = (reinterpret_cast<uintptr_t>(name) >> 3) & (kMaxZones - 1);
+    for (size_t probe = 0; probe < kMaxZones; ++probe) {
+        ZoneSlot& slot = zones_[(index + probe) & (kMaxZones - 1)];
+        const char* current = slot.name.load(std::memory_order_acquire);
+        if (current == name) {
+            return slot;
+        }
+        if (current == nullptr) {
+            if (slot.name.compare_exchange_strong(current, name, std::memory_order_acq_rel) ||
+                current == name) {
+                return slot;
+            }
+        }
+    }
+    return overflowZone_;
+}
+
+void AllocationTracker::onAllocate(size_t bytes) {
+    if (tlsInHook) {
+        return;
+    }
+    tlsInHook = true;
+
+    allocations_.fetch_add(1, std::memory_order_relaxed);
+    bytes_.fetch_add(bytes, std::memory_order_relaxed);
+
+    const char* zone = tlsZone ? tlsZone : kUnscopedZone;
+    ZoneSlot& slot = findZone(zone);
+    slot.allocations.fetch_add(1, std::memory_order_relaxed);
+    slot.bytes.fetch_add(bytes, std::memory_order_relaxed);
+
+    if (tlsAuditDepth > 0 && auditArmed_.load(std::memory_order_relaxed)) {
+        violations_.fetch_add(1, std::memory_order_relaxed);
+        const char* expected = nullptr;
+        firstViolationZone_.compare_exchange_strong(expected, zone, std::memory_order_relaxed);
+
+        if (auditAction_ == AllocationAuditAction::Abort) {
+            std::fprintf(stderr, "Allocation audit: %zu-byte allocation in zone '%s' (frame %llu)\n",
+                         bytes, zone, static_cast<unsigned long long>(frameIndex_));
+            std::abort();
+        }
+    }
+
+    tlsInHook = false;
+}
+
+void AllocationTracker::onFree() {
+    frees_.fetch_add(1, std::memory_order_relaxed);
+}
+
+// ---------------------------------------------------------------------------
+// Frame bookkeeping
+// ---------------------------------------------------------------------------
+
+void AllocationTracker::beginFrame() {
+    lastFrame_.allocations = allocations_.exchange(0, std::memory_order_relaxed);
+    lastFrame_.frees = frees_.exchange(0, std::memory_order_relaxed);
+    lastFrame_.bytes = bytes_.exchange(0, std::memory_order_relaxed);
+    lastFrame_.auditViolations = violations_.exchange(0, std::memory_order_relaxed);
+    const char* violationZone = firstViolationZone_.exchange(nullptr, std::memory_order_relaxed);
+
+    totals_.allocations += lastFrame_.allocations;
+    totals_.frees += lastFrame_.frees;
+    totals_.bytes += lastFrame_.bytes;
+    totals_.auditViolations += lastFrame_.auditViolations;
+
+    // Snapshot the zone table (capacity is reserved once, so this stays allocation-free)
+    if (lastFrameZones_.capacity() < kMaxZones + 1) {
+        lastFrameZones_.reserve(kMaxZones + 1);
+    }
+    lastFrameZones_.clear();
+    auto collect = [this](ZoneSlot& slot, const char* name) {
+        uint64_t allocations = slot.allocations.exchange(0, std::memory_order_relaxed);
+        uint64_t bytes = slot.bytes.exchange(0, std::memory_order_relaxed);
+        if (allocations > 0) {
+            lastFrameZones_.push_back({name, allocations, bytes});
+        }
+    };
+    for (ZoneSlot& slot : zones_) {
+        const char* name = slot.name.load(std::memory_order_acquire);
+        if (name) {
+            collect(slot, name);
+        }
+    }
+    collect(overflowZone_, kOverflowZone);
+    std::sort(lastFrameZones_.begin(), lastFrameZones_.end(),
+        [](const ZoneCounters& a, const ZoneCounters& b) {
+            return a.allocations > b.allocations;
+        });
+
+    if (lastFrame_.auditViolations > 0) {
+        reportViolations(lastFrame_, violationZone);
+    }
+
+    ++frameIndex_;
+    auditArmed_.store(isAuditEnabled() && frameIndex_ > auditWarmupFrames_,
+                      std::memory_order_relaxed);
+}
+
+void AllocationTracker::reportViolations(const FrameCounters& frame, const char* firstZone) {
+    LOG_WARNING_FMT("Allocation audit: frame %llu made %llu heap allocations in audited scopes (first in '%s')",
+                    static_cast<unsigned long long>(frameIndex_),
+                    static_cast<unsigned long long>(frame.auditViolations),
+                    firstZone ? firstZone : kUnscopedZone);
+
+    // Top zones (all threads - the audit only counts audited scopes)
+    size_t shown = std::min<size_t>(lastFrameZones_.size(), 5);
+    for (size_t i = 0; i < shown; ++i) {
+        const ZoneCounters& zone = lastFrameZones_[i];
+        LOG_WARNING_FMT("  %-32s %6llu allocs %10llu bytes", zone.name,
+                        static_cast<unsigned long long>(zone.allocations),
+                        static_cast<unsigned long long>(zone.bytes));
+    }
+}
+
+AllocationTracker::FrameCounters AllocationTracker::getCurrentFrame() const {
+    FrameCounters frame;
+    frame.allocations = allocations_.load(std::memory_order_relaxed);
+    frame.frees = frees_.load(std::memory_order_relaxed);
+    frame.bytes = bytes_.load(std::memory_order_relaxed);
+    frame.auditViolations = violations_.load(std::memory_order_relaxed);
+    return frame;
+}
+
+AllocationTracker::FrameCounters AllocationTracker::getTotals() const {
+    return totals_;
+}
+
+// ---------------------------------------------------------------------------
+// Scopes
+// ---------------------------------------------------------------------------
+
+AllocationScope::AllocationScope(const char* name)
+    : previous_(tlsZone) {
+    tlsZone = name;
+}
+
+AllocationScope::~AllocationScope() {
+    tlsZone = previous_;
+}
+
+const char* AllocationScope::current() {
+    return tlsZone;
+}
+
+AllocationAuditScope::AllocationAuditScope() {
+    ++tlsAuditDepth;
+}
+
+AllocationAuditScope::~AllocationAuditScope() {
+    --tlsAuditDepth;
+}
+
+AllocationAuditScope::Suspend::Suspend()
+    : savedDepth_(tlsAuditDepth) {
+    tlsAuditDepth = 0;
+}
+
+AllocationAuditScope::Suspend::~Suspend() {
+    tlsAuditDepth = savedDepth_;
+}
+
+} // namespace Engine
+
+// ---------------------------------------------------------------------------
+// Global operator new/delete replacements
+// ---------------------------------------------------------------------------
+
+#if ENGINE_ALLOC_TRACKING
+
+namespace {
+
+void* trackedAlloc(size_t size) {
+    Engine::AllocationTracker::getInstance().onAllocate(size);
+    return std::malloc(size ? size : 1);
+}
+
+void* trackedAlignedAlloc(size_t size, std::align_val_t alignment) {
+    Engine::AllocationTracker::getInstance().onAllocate(size);
+    size_t align = static_cast<size_t>(alignment);
+    if (align < sizeof(void*)) {
+        align = sizeof(void*);
+    }
+#ifdef _WIN32
+    return _aligned_malloc(size ? size : 1, align);
+#else
+    void* ptr = nullptr;
+    if (posix_memalign(&ptr, align, size ? size : 1) != 0) {
+        return nullptr;
+    }
+    return ptr;
+#endif
+}
+
+void trackedFree(void* ptr) {
+    if (ptr) {
+        Engine::AllocationTracker::getInstance().onFree();
+        std::free(ptr);
+    }
+}
+
+void trackedAlignedFree(void* ptr) {
+    if (ptr) {
+        Engine::AllocationTracker::getInstance().onFree();
+#ifdef _WIN32
+        _aligned_free(ptr);
+#else
+        std::free(ptr);
+#endif
+    }
+}
+
+} // anonymous namespace
+
+void* operator new(size_t size) {
+    void* ptr = trackedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size) {
+    void* ptr = trackedAlloc(size);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+void* operator new[](size_t size, const std::nothrow_t&) noexcept { return trackedAlloc(size); }
+
+void* operator new(size_t size, std::align_val_t alignment) {
+    void* ptr = trackedAlignedAlloc(size, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new[](size_t size, std::align_val_t alignment) {
+    void* ptr = trackedAlignedAlloc(size, alignment);
+    if (!ptr) throw std::bad_alloc();
+    return ptr;
+}
+
+void* operator new(size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAlignedAlloc(size, alignment);
+}
+void* operator new[](size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+    return trackedAlignedAlloc(size, alignment);
+}
+
+void operator delete(void* ptr) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, size_t) noexcept { trackedFree(ptr); }
+void operator delete(void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept { trackedFree(ptr); }
+
+void operator delete(void* ptr, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete(void* ptr, size_t, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, size_t, std::align_val_t) noexcept { trackedAlignedFree(ptr); }
+void operator delete(void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(ptr); }
+void operator delete[](void* ptr, std::align_val_t, const std::nothrow_t&) noexcept { trackedAlignedFree(ptr); }
+
+#endif // ENGINE_ALLOC_TRACKING
@@ -0,0 +1,54 @@
+#include "engine/BlendTable.h"
+#include "engine/Palette.h"
+#include "engine/Profiler.h"
+#include "engine/WorkerPool.h"
+#include <algorithm>
+
+namespace Engine {
+
+namespace {
+
+// x / 255, rounded, for x in [0, 255 * 255]
+inline int div255(int x) {
+    return (x + 128 + ((x + 128) >> 8)) >> 8;
+}
+
+inline uint8_t blendChannel(BlendMode mode, int s, int d, int a) {
+    switch (mode) {
+        case BlendMode::Alpha:
+            return static_cast<uint8_t>(div255(s * a + d * (255 - a)));
+        case BlendMode::Additive:
+            return static_cast<uint8_t>(std::min(255, d + div255(s * a)));
+        case BlendMode::Multiply:
+            return static_cast<uint8_t>(div255(div255(s * d) * a + d * (255 - a)));
+        case BlendMode::Subtract:
+            return static_cast<uint8_t>(std::max(0, d - div255(s * a)));
+    }
+    return static_cast<uint8_t>(d);
+}
+
+} // anonymous namespace
+
+std::shared_ptr<const BlendTable> BlendTable::create(const Palette& palette, BlendMode mode, uint8_t alpha) {
+    PROFILE_ZONE("BlendTable::create");
+
+    std::shared_ptr<BlendTable> table(new BlendTable(mode, alpha));
+    std::shared_ptr<const Palette::InverseTable> inverse = palette.getInverseTable();
+    const Color* colors = palette.getColors().data();
+
+    // One task per source index; each fills its own 256-byte row
+    WorkerPool::getInstance().parallelFor(256, [&](int src) {
+        const Color& s = colors[src];
+        uint8_t* row = &table->table_[static_cast<size_t>(src) << 8];
+        for (int dest = 0; dest < 256; ++dest) {
+            const Color& d = colors[dest];
+            Color blended{blendChannel(mode, s.r, d.r, alpha),
+                          blendChannel(mode, s.g, d.g, alpha),
+                          blendChannel(mode, s.b, d.b, alpha), d.a};
+            row[dest] = inverse->findNearest(blended, colors);
+        }
+    });
+    return table;
+}
+
+} // namespace Engine
@@ -5,9 +5,13 @@
 #include "engine/IRenderable.h"
 #include "engine/ICollidable.h"
 #include "engine/IOnDebug.h"
+#include "engine/Profiler.h"
+#include "engine/WorkerPool.h"
 #include <SDL.h>
 #include <algorithm>
+#include <cstdlib>
 #include <iostream>
+#include <random>
 
 namespace Engine {
 
@@ -29,8 +33,37 @@ bool Engine::init(const EngineConfig& config, RendererPtr renderer) {
         LOG_INFO("Logging to file: " + config.logFilePath);
     }
 
+    if (config.asyncLogging) {
+        logger.setAsync(true);
+    }
+
     LOG_INFO("Initializing engine...");
 
+    // Configure profiler (zones are compiled out of release builds unless ENGINE_PROFILER_ENABLED=1)
+    profilerTracePath_ = config.profilerTracePath;
+    if (config.enableProfiler) {
+        Profiler::getInstance().setEnabled(true);
+        Profiler::getInstance().setThreadName("Main");
+        LOG_INFO("Profiler enabled");
+    }
+
+    // Start the worker threads now rather than inside the first parallel effect
+    WorkerPool::getInstance().setThreadCount(config.workerThreads);
+    LOG_INFO_FMT("Worker pool: %d threads", WorkerPool::getInstance().getThreadCount());
+
+    // Configure allocation audit
+    if (config.allocationAudit) {
+        if (AllocationTracker::isCompiledIn()) {
+            auto& tracker = AllocationTracker::getInstance();
+            tracker.setAuditWarmupFrames(static_cast<uint64_t>(std::max(config.allocationAuditWarmupFrames, 0)));
+            tracker.setAuditAction(config.allocationAuditAction);
+            tracker.setAuditEnabled(true);
+            LOG_INFO_FMT("Allocation audit enabled after %d warm-up frames", config.allocationAuditWarmupFrames);
+        } else {
+            LOG_WARNING("Allocation audit requested but tracking is not compiled in (build with ENGINE_ENABLE_ALLOC_TRACKING=ON)");
+        }
+    }
+
     // Create default SDL renderer if none provided
     if (!renderer) {
         renderer = std::make_unique<SDLRenderer>();
@@ -46,6 +79,25 @@ bool Engine::init(const EngineConfig& config, RendererPtr renderer) {
 
     LOG_INFO_STREAM("Renderer initialized: " << config.width << "x" << config.height);
 
+    vsync_ = config.vsync;
+    if (!vsync_ && !renderer_->setVSync(false)) {
+        LOG_WARNING("Renderer cannot disable vsync; frame times include vblank waits");
+        vsync_ = true;
+    }
+
+    // Replay mode pins the RNG seed and timestep so runs are reproducible
+    title_ = config.title;
+    if (config.replay.isEnabled()) {
+        replay_ = std::make_unique<ReplayRecorder>(config.replay);
+        randomSeed_ = config.replay.seed;
+        LOG_INFO_STREAM("Replay mode: " << config.replay.frames << " frames at dt="
+                        << config.replay.deltaTime << "s, seed " << randomSeed_);
+    } else {
+        replay_.reset();
+        randomSeed_ = std::random_device{}();
+    }
+    std::srand(randomSeed_);
+
     // Initialize resource manager with renderer
     resourceManager_.init(renderer_.get());
     LOG_DEBUG("Resource manager initialized");
@@ -88,6 +140,16 @@ void Engine::shutdown() {
         renderer_->shutdown();
     }
     running_ = false;
+
+    // Dump the profiler trace once (shutdown also runs from the destructor)
+    if (!profilerTracePath_.empty() && Profiler::getInstance().isEnabled()) {
+        if (Profiler::getInstance().writeChromeTrace(profilerTracePath_)) {
+            LOG_INFO("Profiler trace written to " + profilerTracePath_);
+        }
+        profilerTracePath_.clear();
+    }
+
+    Logger::getInstance().flush();
 }
 
 std::shared_ptr<Layer> Engine::createLayer(int renderOrder) {
@@ -121,8 +183,13 @@ void Engine::sortLayers() {
 
 void Engine::render() {
     if (!renderer_) return;
+    AllocationAuditScope allocationAudit;
+    PROFILE_ZONE("Engine::render");
 
-    renderer_->clear();
+    {
+        PROFILE_ZONE("Renderer::clear");
+        renderer_->clear();
+    }
 
     // Render all layers in order (lowest render order first)
     for (const auto& layer : layers_) {
@@ -130,15 +197,23 @@ void Engine::render() {
     }
 
     // Render IRenderable objects (sorted by render order)
-    auto sortedRenderables = renderables_;
-    std::sort(sortedRenderables.begin(), sortedRenderables.end(),
-        [](const auto& a, const auto& b) {
-            return a.second->getRenderOrder() < b.second->getRenderOrder();
-        });
+    {
+        PROFILE_ZONE("Engine::renderables");
 
-    for (const auto& [obj, renderable] : sortedRenderables) {
-        if (obj->isActive()) {
-            renderable->render(*renderer_);
+        // Sort raw pointers in a reused scratch vector - no per-frame copy of the shared_ptrs
+        sortedRenderables_.clear();
+        for (const auto& [obj, renderable] : renderables_) {
+            sortedRenderables_.emplace_back(obj.get(), renderable);
+        }
+        std::sort(sortedRenderables_.begin(), sortedRenderables_.end(),
+            [](const auto& a, const auto& b) {
+                return a.second->getRenderOrder() < b.second->getRenderOrder();
+            });
+
+        for (const auto& [obj, renderable] : sortedRenderables_) {
+            if (obj->isActive()) {
+                renderable->render(*renderer_);
+            }
         }
     }
 
@@ -151,7 +226,42 @@ void Engine::render() {
         }
     }
 
-    renderer_->present();
+    // Capture the final replay frame before present() - back buffers are
+    // undefined after a flip. The one-off readback and report are not frame work,
+    // so they run outside the allocation audit.
+    if (replay_ && replay_->isLastFrame()) {
+        AllocationAuditScope::Suspend suspendAudit;
+        if (renderer_->readPixels(replayPixels_)) {
+            replay_->setFinalFrame(replayPixels_, renderer_->getViewportWidth(), renderer_->getViewportHeight());
+        } else {
+            LOG_WARNING("Renderer does not support readPixels; replay report has no framebuffer hash");
+        }
+    }
+
+    {
+        PROFILE_ZONE("Renderer::present");
+        renderer_->present();
+    }
+
+    if (replay_) {
+        replay_->endFrame();
+        if (running_ && replay_->isFinished()) {
+            AllocationAuditScope::Suspend suspendAudit;
+            finishReplay();
+        }
+    }
+}
+
+void Engine::finishReplay() {
+    auto summary = replay_->getStats().getSummary();
+    LOG_INFO_STREAM("Replay finished: " << summary.totalFrames << " frames, p50 "
+                    << summary.p50Ms << " ms, p99 " << summary.p99Ms << " ms, max "
+                    << summary.maxMs << " ms");
+
+    if (replay_->writeReport(title_, vsync_)) {
+        LOG_INFO("Replay report written to " + replay_->getConfig().reportPath);
+    }
+    running_ = false;
 }
 
 // GameObject management
@@ -186,6 +296,7 @@ GameObjectPtr Engine::findGameObject(const std::string& name) {
 
 // Event polling
 bool Engine::pollEvents() {
+    PROFILE_ZONE("Engine::pollEvents");
     SDL_Event e;
     while (SDL_PollEvent(&e)) {
         if (e.type == SDL_QUIT) {
@@ -203,9 +314,18 @@ void Engine::update(float deltaTime) {
     // Increment frame counter and update logger
     frameNumber_++;
     Logger::getInstance().setFrameNumber(frameNumber_);
-
-    // Auto-calculate deltaTime if not provided
-    if (deltaTime < 0.0f) {
+    if (AllocationTracker::isCompiledIn()) {
+        AllocationTracker::getInstance().beginFrame();
+    }
+    AllocationAuditScope allocationAudit;
+    PROFILE_FRAME();
+    PROFILE_ZONE("Engine::update");
+
+    if (replay_) {
+        replay_->beginFrame();
+        deltaTime = replay_->getConfig().deltaTime;
+    } else if (deltaTime < 0.0f) {
+        // Auto-calculate deltaTime if not provided
         Uint32 currentTime = SDL_GetTicks();
         if (lastFrameTime_ == 0) {
             // First frame
@@ -228,9 +348,12 @@ void Engine::update(float deltaTime) {
     }
 
     // Process input for this frame
-    for (const auto& [obj, handler] : inputHandlers_) {
-        if (obj->isActive()) {
-            handler->handleInput(input_);
+    {
+        PROFILE_ZONE("Engine::dispatchInput");
+        for (const auto& [obj, handler] : inputHandlers_) {
+            if (obj->isActive()) {
+                handler->handleInput(input_);
+            }
         }
     }
 
@@ -249,6 +372,7 @@ void Engine::processInput(SDL_Event& event) {
 }
 
 void Engine::updateGameObjects(float deltaTime) {
+    PROFILE_ZONE("Engine::updateGameObjects");
     for (const auto& [obj, updateable] : updateables_) {
         if (obj->isActive()) {
             updateable->update(deltaTime);
@@ -257,6 +381,7 @@ void Engine::updateGameObjects(float deltaTime) {
 }
 
 void Engine::fixedUpdate() {
+    PROFILE_ZONE("Engine::fixedUpdate");
     for (const auto& [obj, fixedUpdateable] : fixedUpdateables_) {
         if (obj->isActive()) {
             fixedUpdateable->fixedUpdate(fixedTimestep_);
@@ -265,6 +390,7 @@ void Engine::fixedUpdate() {
 }
 
 void Engine::checkCollisions() {
+    PROFILE_ZONE("Engine::checkCollisions");
     // Simple O(n²) collision check - can be optimized with spatial partitioning later
     for (size_t i = 0; i < collidables_.size(); ++i) {
         auto& [objA, collidableA] = collidables_[i];
@@ -302,6 +428,7 @@ void Engine::checkCollisions() {
 }
 
 void Engine::cleanupDestroyedObjects() {
+    PROFILE_ZONE("Engine::cleanupDestroyedObjects");
     // Remove from gameObjects list
     auto it = std::remove_if(gameObjects_.begin(), gameObjects_.end(),
         [](const GameObjectPtr& obj) {
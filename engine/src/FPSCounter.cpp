@@ -1,51 +1,54 @@
 #include "engine/FPSCounter.h"
-#include <numeric>
 #include <algorithm>
 
 namespace Engine {
 
-FPSCounter::FPSCounter(int sampleSize)
-    : sampleSize_(sampleSize)
-    , lastFrameTime_(SDL_GetTicks())
+FPSCounter::FPSCounter(int sampleSize, size_t statsCapacity)
+    : frameTimes_(std::max(sampleSize, 1), 0.0f)
+    , lastCounter_(SDL_GetPerformanceCounter())
+    , counterToMs_(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency()))
     , currentFPS_(0.0f)
     , frameTime_(0.0f)
-    , deltaTime_(0.0f) {
+    , deltaTime_(0.0f)
+    , stats_(statsCapacity) {
 }
 
 void FPSCounter::update() {
-    Uint32 currentTime = SDL_GetTicks();
-    Uint32 frameDelta = currentTime - lastFrameTime_;
-    lastFrameTime_ = currentTime;
+    Uint64 currentCounter = SDL_GetPerformanceCounter();
+    float frameDeltaMs = static_cast<float>((currentCounter - lastCounter_) * counterToMs_);
+    lastCounter_ = currentCounter;
 
-    // Store frame time
-    frameTimes_.push_back(frameDelta);
-
-    // Keep only the last N samples
-    if (frameTimes_.size() > static_cast<size_t>(sampleSize_)) {
-        frameTimes_.pop_front();
-    }
+    // Store frame time, replacing the oldest sample once the window is full
+    frameTimeSum_ -= frameTimes_[nextSample_];
+    frameTimes_[nextSample_] = frameDeltaMs;
+    frameTimeSum_ += frameDeltaMs;
+    nextSample_ = (nextSample_ + 1) % frameTimes_.size();
+    sampleCount_ = std::min(sampleCount_ + 1, frameTimes_.size());
 
     // Calculate average frame time
-    if (!frameTimes_.empty()) {
-        float sum = std::accumulate(frameTimes_.begin(), frameTimes_.end(), 0.0f);
-        frameTime_ = sum / frameTimes_.size();
-
-        // Calculate FPS (avoid division by zero)
-        if (frameTime_ > 0.0f) {
-            currentFPS_ = 1000.0f / frameTime_;
-        }
+    frameTime_ = static_cast<float>(frameTimeSum_ / sampleCount_);
+
+    // Calculate FPS (avoid division by zero)
+    if (frameTime_ > 0.0f) {
+        currentFPS_ = 1000.0f / frameTime_;
     }
 
     // Delta time in seconds
-    deltaTime_ = frameDelta / 1000.0f;
+    deltaTime_ = frameDeltaMs / 1000.0f;
+
+    stats_.addSample(frameDeltaMs);
 }
 
 void FPSCounter::reset() {
-    frameTimes_.clear();
-    lastFrameTime_ = SDL_GetTicks();
+    std::fill(frameTimes_.begin(), frameTimes_.end(), 0.0f);
+    nextSample_ = 0;
+    sampleCount_ = 0;
+    frameTimeSum_ = 0.0;
+    lastCounter_ = SDL_GetPerformanceCounter();
     currentFPS_ = 0.0f;
     frameTime_ = 0.0f;
     deltaTime_ = 0.0f;
+    stats_.reset();
 }
 
 } // namespace Engine
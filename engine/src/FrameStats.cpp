@@ -0,0 +1,106 @@
+#include "engine/FrameStats.h"
+#include <algorithm>
+#include <cmath>
+
+namespace Engine {
+
+FrameStats::FrameStats(size_t capacity, float budgetMs)
+    : samples_(std::max<size_t>(capacity, 1), 0.0f)
+    , budgetMs_(budgetMs)
+    , counterToMs_(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency())) {
+    sortScratch_.reserve(samples_.size());
+}
+
+void FrameStats::tick() {
+    Uint64 now = SDL_GetPerformanceCounter();
+    if (lastCounter_ != 0) {
+        addSample(static_cast<float>((now - lastCounter_) * counterToMs_));
+    }
+    lastCounter_ = now;
+}
+
+void FrameStats::addSample(float frameTimeMs) {
+    samples_[head_] = frameTimeMs;
+    head_ = (head_ + 1) % samples_.size();
+    if (count_ < samples_.size()) {
+        ++count_;
+    }
+
+    lastFrameMs_ = frameTimeMs;
+    ++totalFrames_;
+    if (frameTimeMs > budgetMs_) {
+        ++hitchCount_;
+    }
+}
+
+void FrameStats::sortWindow() const {
+    // Ring order doesn't matter once sorted; the valid samples are the first
+    // count_ entries until the buffer wraps, then all of them
+    sortScratch_.assign(samples_.begin(), samples_.begin() + count_);
+    std::sort(sortScratch_.begin(), sortScratch_.end());
+}
+
+float FrameStats::getPercentile(float p) const {
+    if (count_ == 0) {
+        return 0.0f;
+    }
+
+    sortWindow();
+    float clamped = std::clamp(p, 0.0f, 100.0f);
+    size_t rank = static_cast<size_t>(std::ceil(clamped / 100.0f * count_));
+    return sortScratch_[rank > 0 ? rank - 1 : 0];
+}
+
+FrameStats::Summary FrameStats::getSummary() const {
+    Summary summary;
+    summary.samples = count_;
+    summary.hitches = hitchCount_;
+    summary.totalFrames = totalFrames_;
+    if (count_ == 0) {
+        return summary;
+    }
+
+    sortWindow();
+
+    auto percentile = [this](float p) {
+        size_t rank = static_cast<size_t>(std::ceil(p / 100.0f * count_));
+        return sortScratch_[rank > 0 ? rank - 1 : 0];
+    };
+
+    double sum = 0.0;
+    for (float sample : sortScratch_) {
+        sum += sample;
+    }
+
+    summary.meanMs = static_cast<float>(sum / count_);
+    summary.minMs = sortScratch_.front();
+    summary.p50Ms = percentile(50.0f);
+    summary.p95Ms = percentile(95.0f);
+    summary.p99Ms = percentile(99.0f);
+    summary.maxMs = sortScratch_.back();
+    return summary;
+}
+
+void FrameStats::computeHistogram(float bucketWidthMs, int bucketCount, std::vector<uint32_t>& out) const {
+    out.assign(std::max(bucketCount, 0), 0);
+    if (bucketCount <= 0 || bucketWidthMs <= 0.0f) {
+        return;
+    }
+
+    for (size_t i = 0; i < count_; ++i) {
+        int bucket = static_cast<int>(samples_[i] / bucketWidthMs);
+        out[std::clamp(bucket, 0, bucketCount - 1)]++;
+    }
+}
+
+void FrameStats::reset() {
+    std::fill(samples_.begin(), samples_.end(), 0.0f);
+    head_ = 0;
+    count_ = 0;
+    lastFrameMs_ = 0.0f;
+    hitchCount_ = 0;
+    totalFrames_ = 0;
+    lastCounter_ = 0;
+}
+
+} // namespace Engine
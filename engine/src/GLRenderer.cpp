@@ -4,8 +4,10 @@
 #include "engine/Text.h"
 #include "engine/PixelBuffer.h"
 #include "engine/IndexedPixelBuffer.h"
+#include "engine/Profiler.h"
 #include <SDL_image.h>
 #include <SDL_ttf.h>
+#include <algorithm>
 #include <iostream>
 #include <cmath>
 
@@ -56,19 +58,31 @@ out vec4 FragColor;
 in vec2 TexCoord;
 
 uniform sampler2D indexTexture;  // R8 texture with palette indices
-uniform sampler2D paletteTexture;  // 256x1 RGBA texture with palette
+uniform sampler2D paletteTexture;  // 256 x banks RGBA texture, one palette bank per row
+uniform isampler2D scanlineTexture;  // 1 x height: (bank, index offset, scrollX) per row
+uniform bool scanlineEffects;  // Evaluate the scanline table
+uniform ivec2 bufferSize;  // Index texture size in pixels
 uniform float opacity;  // Layer opacity (0.0 = fully transparent, 1.0 = fully opaque)
 
 void main() {
-    // Sample the index from the indexed texture
-    // The half-texel offset from the vertex shader ensures we sample texel centers
-    float index = texture(indexTexture, TexCoord).r;
-
-    // Convert normalized index back to 0-255 range and sample at texel center
-    // For pixel-perfect palette lookup, we need to hit the exact center of each palette entry
-    float paletteIndex = index * 255.0;
-    vec2 palCoord = vec2((paletteIndex + 0.5) / 256.0, 0.5);
-    vec4 color = texture(paletteTexture, palCoord);
+    vec4 color;
+    if (scanlineEffects) {
+        // Per-row raster effects: fetch the row's entry, scroll the row, then
+        // offset the index and look it up in the row's palette bank
+        ivec2 pixel = min(ivec2(TexCoord * vec2(bufferSize)), bufferSize - 1);
+        ivec4 effect = texelFetch(scanlineTexture, ivec2(0, pixel.y), 0);
+        int x = pixel.x - effect.b;
+        x -= int(floor(float(x) / float(bufferSize.x))) * bufferSize.x;  // GLSL % is undefined for negatives
+        int index = int(texelFetch(indexTexture, ivec2(x, pixel.y), 0).r * 255.0 + 0.5);
+        color = texelFetch(paletteTexture, ivec2((index + effect.g) & 255, effect.r), 0);
+    } else {
+        // Sample the index from the indexed texture
+        // The half-texel offset from the vertex shader ensures we sample texel centers
+        float index = texture(indexTexture, TexCoord).r;
+
+        // Convert normalized index back to 0-255 and fetch that entry of bank 0
+        color = texelFetch(paletteTexture, ivec2(int(index * 255.0 + 0.5), 0), 0);
+    }
 
     // Apply layer opacity to the alpha channel
     FragColor = vec4(color.rgb, color.a * opacity);
@@ -295,12 +309,38 @@ void GLRenderer::shutdown() {
 }
 
 void GLRenderer::clear() {
+    PROFILE_ZONE("GLRenderer::clear");
     glClearColor(0.0f, 0.0f, 0.0f, 1.0f);
     glClear(GL_COLOR_BUFFER_BIT);
+    beginFrameStats();
 }
 
 void GLRenderer::present() {
+    PROFILE_ZONE("GLRenderer::present");
     SDL_GL_SwapWindow(window_);
+    endFrameStats();
+}
+
+bool GLRenderer::setVSync(bool enabled) {
+    return glContext_ && SDL_GL_SetSwapInterval(enabled ? 1 : 0) == 0;
+}
+
+bool GLRenderer::readPixels(std::vector<Color>& pixels) {
+    if (!glContext_) {
+        return false;
+    }
+
+    pixels.resize(static_cast<size_t>(windowWidth_) * windowHeight_);
+    glPixelStorei(GL_PACK_ALIGNMENT, 1);
+    glReadPixels(0, 0, windowWidth_, windowHeight_, GL_RGBA, GL_UNSIGNED_BYTE, pixels.data());
+
+    // GL rows start at the bottom; flip to top row first
+    for (int y = 0; y < windowHeight_ / 2; ++y) {
+        std::swap_ranges(pixels.begin() + static_cast<size_t>(y) * windowWidth_,
+                         pixels.begin() + static_cast<size_t>(y + 1) * windowWidth_,
+                         pixels.begin() + static_cast<size_t>(windowHeight_ - 1 - y) * windowWidth_);
+    }
+    return glGetError() == GL_NO_ERROR;
 }
 
 // Stub implementations for now - will implement these next
@@ -321,6 +361,7 @@ void GLRenderer::renderPixelBuffer(const PixelBuffer& buffer, const Vec2& layerO
 }
 
 void GLRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("GLRenderer::renderIndexedPixelBuffer");
     if (!buffer.isVisible()) {
         return;
     }
@@ -338,26 +379,47 @@ void GLRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, cons
         mutableBuffer.setGLPaletteTexture(paletteTex);
     }
 
-    // Upload pixel data if dirty
+    // Upload pixel data if dirty (only the dirty rectangle)
     if (mutableBuffer.arePixelsDirty()) {
+        IndexedPixelBuffer::DirtyRect rect = buffer.getDirtyRect();
         updateIndexedTexture(
             mutableBuffer.getGLIndexTexture(),
             buffer.getPixelData(),
             buffer.getWidth(),
-            buffer.getHeight()
+            rect.minX, rect.minY,
+            rect.maxX - rect.minX + 1,
+            rect.maxY - rect.minY + 1
         );
         mutableBuffer.markPixelsClean();
     }
 
     // Upload palette data if dirty (this is the KEY optimization!)
     if (mutableBuffer.isPaletteDirty()) {
-        updatePaletteTexture(
-            mutableBuffer.getGLPaletteTexture(),
-            buffer.getPaletteData()
-        );
+        for (int bank = 0; bank < buffer.getPaletteBankCount(); ++bank) {
+            updatePaletteTexture(
+                mutableBuffer.getGLPaletteTexture(),
+                buffer.getPaletteBankData(bank),
+                bank
+            );
+        }
         mutableBuffer.markPaletteClean();
     }
 
+    // Scanline effects: only the per-row table is uploaded, the shader applies it
+    const ScanlineEffect* effects = buffer.getScanlineEffects();
+    if (effects) {
+        bool created = false;
+        if (mutableBuffer.getGLScanlineTexture() == 0) {
+            mutableBuffer.setGLScanlineTexture(createScanlineTexture(buffer.getHeight()));
+            created = true;
+        }
+        if (created || mutableBuffer.areScanlineEffectsDirty()) {
+            updateScanlineTexture(mutableBuffer.getGLScanlineTexture(), effects, buffer.getHeight(),
+                                  buffer.getPaletteBankCount());
+        }
+    }
+    mutableBuffer.markScanlineEffectsClean();
+
     // Mark buffer as clean
     mutableBuffer.markClean();
 
@@ -365,6 +427,8 @@ void GLRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, cons
     renderIndexedQuad(
         mutableBuffer.getGLIndexTexture(),
         mutableBuffer.getGLPaletteTexture(),
+        effects ? mutableBuffer.getGLScanlineTexture() : 0,
+        buffer.getWidth(), buffer.getHeight(),
         buffer.getPosition() + layerOffset,
         Vec2{buffer.getWidth() * buffer.getScale(), buffer.getHeight() * buffer.getScale()},
         opacity
@@ -408,8 +472,9 @@ unsigned int GLRenderer::createPaletteTexture() {
     glGenTextures(1, &texture);
     glBindTexture(GL_TEXTURE_2D, texture);
 
-    // Create 256x1 RGBA texture for palette
-    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 256, 1, 0, GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
+    // Create 256 x banks RGBA texture, one palette bank per row
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA8, 256, IndexedPixelBuffer::kMaxPaletteBanks, 0,
+                 GL_RGBA, GL_UNSIGNED_BYTE, nullptr);
 
     // Set texture parameters
     glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
@@ -421,13 +486,43 @@ unsigned int GLRenderer::createPaletteTexture() {
     return texture;
 }
 
-void GLRenderer::updateIndexedTexture(unsigned int textureId, const uint8_t* indices, int width, int height) {
+unsigned int GLRenderer::createScanlineTexture(int height) {
+    unsigned int texture;
+    glGenTextures(1, &texture);
+    glBindTexture(GL_TEXTURE_2D, texture);
+
+    // Create 1 x height integer texture: (bank, index offset, scrollX, unused) per row
+    glTexImage2D(GL_TEXTURE_2D, 0, GL_RGBA16I, 1, height, 0, GL_RGBA_INTEGER, GL_SHORT, nullptr);
+
+    // Integer textures must use nearest filtering
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_S, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_WRAP_T, GL_CLAMP_TO_EDGE);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MIN_FILTER, GL_NEAREST);
+    glTexParameteri(GL_TEXTURE_2D, GL_TEXTURE_MAG_FILTER, GL_NEAREST);
+
+    glBindTexture(GL_TEXTURE_2D, 0);
+    return texture;
+}
+
+void GLRenderer::updateIndexedTexture(unsigned int textureId, const uint8_t* indices, int pitch,
+                                      int x, int y, int width, int height) {
+    PROFILE_ZONE("GLRenderer::updateIndexedTexture");
     glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, width, height, GL_RED, GL_UNSIGNED_BYTE, indices);
+
+    // Read the sub-rectangle straight out of the full index buffer
+    glPixelStorei(GL_UNPACK_ALIGNMENT, 1);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, pitch);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, x, y, width, height, GL_RED, GL_UNSIGNED_BYTE,
+                    indices + static_cast<size_t>(y) * pitch + x);
+    glPixelStorei(GL_UNPACK_ROW_LENGTH, 0);
+
     glBindTexture(GL_TEXTURE_2D, 0);
+    ++frameStats_.textureBinds;
+    countUpload(static_cast<uint64_t>(width) * height);
 }
 
-void GLRenderer::updatePaletteTexture(unsigned int textureId, const Color* palette) {
+void GLRenderer::updatePaletteTexture(unsigned int textureId, const Color* palette, int bank) {
+    PROFILE_ZONE("GLRenderer::updatePaletteTexture");
     // Convert Color array to RGBA bytes
     uint8_t paletteData[256 * 4];
     for (int i = 0; i < 256; ++i) {
@@ -438,14 +533,38 @@ void GLRenderer::updatePaletteTexture(unsigned int textureId, const Color* palet
     }
 
     glBindTexture(GL_TEXTURE_2D, textureId);
-    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, paletteData);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, bank, 256, 1, GL_RGBA, GL_UNSIGNED_BYTE, paletteData);
+    glBindTexture(GL_TEXTURE_2D, 0);
+    ++frameStats_.textureBinds;
+    countUpload(sizeof(paletteData));
+}
+
+void GLRenderer::updateScanlineTexture(unsigned int textureId, const ScanlineEffect* effects, int height,
+                                       int bankCount) {
+    PROFILE_ZONE("GLRenderer::updateScanlineTexture");
+    scanlineStaging_.resize(static_cast<size_t>(height) * 4);
+    for (int y = 0; y < height; ++y) {
+        int16_t* texel = &scanlineStaging_[static_cast<size_t>(y) * 4];
+        texel[0] = effects[y].paletteBank < bankCount ? effects[y].paletteBank : 0;  // Like getPaletteBankData
+        texel[1] = effects[y].paletteOffset;
+        texel[2] = effects[y].scrollX;
+        texel[3] = 0;
+    }
+
+    glBindTexture(GL_TEXTURE_2D, textureId);
+    glTexSubImage2D(GL_TEXTURE_2D, 0, 0, 0, 1, height, GL_RGBA_INTEGER, GL_SHORT, scanlineStaging_.data());
     glBindTexture(GL_TEXTURE_2D, 0);
+    ++frameStats_.textureBinds;
+    countUpload(scanlineStaging_.size() * sizeof(int16_t));
 }
 
 void GLRenderer::renderIndexedQuad(unsigned int indexTexture, unsigned int paletteTexture,
+                                   unsigned int scanlineTexture, int bufferWidth, int bufferHeight,
                                    const Vec2& position, const Vec2& size, float opacity) {
+    PROFILE_ZONE("GLRenderer::renderIndexedQuad");
     // Use the palette shader program
     glUseProgram(paletteShaderProgram_);
+    ++frameStats_.pipelineSwitches;
 
     // Set up orthographic projection matrix
     float left = 0.0f;
@@ -485,10 +604,20 @@ void GLRenderer::renderIndexedQuad(unsigned int indexTexture, unsigned int palet
     glBindTexture(GL_TEXTURE_2D, paletteTexture);
     glUniform1i(glGetUniformLocation(paletteShaderProgram_, "paletteTexture"), 1);
 
+    glUniform1i(glGetUniformLocation(paletteShaderProgram_, "scanlineEffects"), scanlineTexture != 0);
+    glUniform2i(glGetUniformLocation(paletteShaderProgram_, "bufferSize"), bufferWidth, bufferHeight);
+    glActiveTexture(GL_TEXTURE2);
+    glBindTexture(GL_TEXTURE_2D, scanlineTexture);
+    glUniform1i(glGetUniformLocation(paletteShaderProgram_, "scanlineTexture"), 2);
+
     // Draw quad
     glBindVertexArray(quadVAO_);
     glDrawArrays(GL_TRIANGLES, 0, 6);
     glBindVertexArray(0);
+
+    frameStats_.textureBinds += scanlineTexture ? 3 : 2;  // Index + palette (+ scanline table)
+    ++frameStats_.drawCalls;
+    ++frameStats_.quads;
 }
 
 } // namespace Engine
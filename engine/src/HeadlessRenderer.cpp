@@ -0,0 +1,426 @@
+#include "engine/HeadlessRenderer.h"
+#include "engine/Sprite.h"
+#include "engine/Tilemap.h"
+#include "engine/Text.h"
+#include "engine/PixelBuffer.h"
+#include "engine/IndexedPixelBuffer.h"
+#include "engine/Profiler.h"
+#include <SDL_image.h>
+#include <algorithm>
+#include <cmath>
+#include <iostream>
+
+namespace Engine {
+
+namespace {
+
+// Source-over blend of src onto dst, with src alpha scaled by opacity (0-255)
+inline void blendOver(Color& dst, const Color& src, int opacity) {
+    int a = (src.a * opacity + 127) / 255;
+    if (a <= 0) {
+        return;
+    }
+    if (a >= 255) {
+        dst = Color{src.r, src.g, src.b, 255};
+        return;
+    }
+
+    int inv = 255 - a;
+    dst.r = static_cast<uint8_t>((src.r * a + dst.r * inv + 127) / 255);
+    dst.g = static_cast<uint8_t>((src.g * a + dst.g * inv + 127) / 255);
+    dst.b = static_cast<uint8_t>((src.b * a + dst.b * inv + 127) / 255);
+    dst.a = static_cast<uint8_t>(a + (dst.a * inv + 127) / 255);
+}
+
+// Nearest-neighbour scaled composite of an axis-aligned source image
+// sample(sx, sy) returns the source color at integer source coordinates
+template<typename Sampler>
+void compositeScaled(std::vector<Color>& framebuffer, int fbWidth, int fbHeight,
+                     int dstX, int dstY, int dstW, int dstH,
+                     int srcW, int srcH, int opacity, Sampler sample) {
+    if (dstW <= 0 || dstH <= 0 || srcW <= 0 || srcH <= 0) {
+        return;
+    }
+
+    // Clip destination rectangle to the framebuffer once
+    int x0 = std::max(dstX, 0);
+    int y0 = std::max(dstY, 0);
+    int x1 = std::min(dstX + dstW, fbWidth);
+    int y1 = std::min(dstY + dstH, fbHeight);
+
+    for (int y = y0; y < y1; ++y) {
+        int sy = static_cast<int>((static_cast<int64_t>(y - dstY) * srcH) / dstH);
+        Color* row = &framebuffer[y * fbWidth];
+        for (int x = x0; x < x1; ++x) {
+            int sx = static_cast<int>((static_cast<int64_t>(x - dstX) * srcW) / dstW);
+            blendOver(row[x], sample(sx, sy), opacity);
+        }
+    }
+}
+
+} // anonymous namespace
+
+bool HeadlessRenderer::init(const std::string& title, int width, int height) {
+    (void)title;
+
+    if (width <= 0 || height <= 0) {
+        std::cerr << "HeadlessRenderer: invalid framebuffer size " << width << "x" << height << std::endl;
+        return false;
+    }
+
+    width_ = width;
+    height_ = height;
+    framebuffer_.assign(static_cast<size_t>(width) * height, clearColor_);
+    frameCount_ = 0;
+    initialized_ = true;
+    return true;
+}
+
+void HeadlessRenderer::shutdown() {
+    framebuffer_.clear();
+    framebuffer_.shrink_to_fit();
+    width_ = 0;
+    height_ = 0;
+    initialized_ = false;
+}
+
+void HeadlessRenderer::clear() {
+    PROFILE_ZONE("HeadlessRenderer::clear");
+    std::fill(framebuffer_.begin(), framebuffer_.end(), clearColor_);
+    beginFrameStats();
+}
+
+void HeadlessRenderer::present() {
+    // Nothing to flip - the framebuffer stays readable until the next clear()
+    ++frameCount_;
+    endFrameStats();
+}
+
+Color HeadlessRenderer::getPixel(int x, int y) const {
+    if (x < 0 || x >= width_ || y < 0 || y >= height_) {
+        return Color{0, 0, 0, 0};
+    }
+    return framebuffer_[y * width_ + x];
+}
+
+bool HeadlessRenderer::readPixels(std::vector<Color>& pixels) {
+    pixels = framebuffer_;
+    return initialized_;
+}
+
+int HeadlessRenderer::toOpacity(float opacity) {
+    return std::clamp(static_cast<int>(opacity * 255.0f + 0.5f), 0, 255);
+}
+
+void HeadlessRenderer::renderSprite(const Sprite& sprite, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("HeadlessRenderer::renderSprite");
+    if (!sprite.isVisible() || !sprite.getTexture() || !sprite.getTexture()->isValid()) {
+        return;
+    }
+
+    auto texture = sprite.getTexture();
+    const auto* texData = static_cast<const HeadlessTexture*>(texture->getHandle());
+    Vec2 pos = sprite.getLayerPosition() + layerOffset;  // Apply layer offset
+    const auto& scale = sprite.getScale();
+
+    // Determine source rectangle (same rules as the SDL backend)
+    int srcX = 0;
+    int srcY = 0;
+    int srcW = texData->width;
+    int srcH = texData->height;
+    if (sprite.hasSourceRect()) {
+        const auto& src = sprite.getSourceRect();
+        srcX = static_cast<int>(src.x);
+        srcY = static_cast<int>(src.y);
+        srcW = static_cast<int>(src.w);
+        srcH = static_cast<int>(src.h);
+    }
+
+    int dstW = static_cast<int>(srcW * scale.x);
+    int dstH = static_cast<int>(srcH * scale.y);
+
+    drawTextureRect(*texData, srcX, srcY, srcW, srcH,
+                    static_cast<int>(pos.x), static_cast<int>(pos.y), dstW, dstH,
+                    sprite.getRotation(), toOpacity(opacity));
+}
+
+void HeadlessRenderer::renderTilemap(const Tilemap& tilemap, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("HeadlessRenderer::renderTilemap");
+    if (!tilemap.isVisible() || !tilemap.getTileset() || !tilemap.getTileset()->isValid()) {
+        return;
+    }
+
+    const auto* tileset = static_cast<const HeadlessTexture*>(tilemap.getTileset()->getHandle());
+    Vec2 pos = tilemap.getPosition() + layerOffset;  // Apply layer offset
+    int tileWidth = tilemap.getTileWidth();
+    int tileHeight = tilemap.getTileHeight();
+    int tilesPerRow = tilemap.getTilesPerRow();
+    int alpha = toOpacity(opacity);
+
+    if (tilesPerRow <= 0) return;
+
+    for (int y = 0; y < tilemap.getHeight(); ++y) {
+        for (int x = 0; x < tilemap.getWidth(); ++x) {
+            int tileId = tilemap.getTile(x, y);
+            if (tileId < 0) continue;  // Skip empty tiles
+
+            int srcX = (tileId % tilesPerRow) * tileWidth;
+            int srcY = (tileId / tilesPerRow) * tileHeight;
+
+            drawTextureRect(*tileset, srcX, srcY, tileWidth, tileHeight,
+                            static_cast<int>(pos.x + x * tileWidth),
+                            static_cast<int>(pos.y + y * tileHeight),
+                            tileWidth, tileHeight, 0.0f, alpha);
+        }
+    }
+}
+
+void HeadlessRenderer::renderText(const Text& text, const Vec2& position, float opacity) {
+    // TTF text is rasterized into an SDL_Texture by Text itself, which needs an
+    // SDL_Renderer. Use PixelFont + PixelBuffer/IndexedPixelBuffer for headless text.
+    (void)text;
+    (void)position;
+    (void)opacity;
+}
+
+void HeadlessRenderer::renderPixelBuffer(const PixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("HeadlessRenderer::renderPixelBuffer");
+    if (!buffer.isVisible()) {
+        return;
+    }
+
+    // Pixels are read straight from the buffer - no texture upload needed
+    const Color* pixels = buffer.getPixelData();
+    int width = buffer.getWidth();
+    Vec2 pos = buffer.getPosition() + layerOffset;
+    float scale = buffer.getScale();
+
+    countQuad(pixels);
+    compositeScaled(framebuffer_, width_, height_,
+                    static_cast<int>(pos.x), static_cast<int>(pos.y),
+                    static_cast<int>(width * scale), static_cast<int>(buffer.getHeight() * scale),
+                    width, buffer.getHeight(), toOpacity(opacity),
+                    [pixels, width](int sx, int sy) -> const Color& {
+                        return pixels[sy * width + sx];
+                    });
+
+    const_cast<PixelBuffer&>(buffer).markClean();
+}
+
+void HeadlessRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("HeadlessRenderer::renderIndexedPixelBuffer");
+    if (!buffer.isVisible()) {
+        return;
+    }
+
+    // Palette lookup happens per pixel while compositing - no RGBA conversion pass
+    const uint8_t* indices = buffer.getPixelData();
+    const Color* palette = buffer.getPaletteData();
+    int width = buffer.getWidth();
+    Vec2 pos = buffer.getPosition() + layerOffset;
+    float scale = buffer.getScale();
+
+    countQuad(indices);
+    if (const ScanlineEffect* effects = buffer.getScanlineEffects()) {
+        // Raster effects: scroll, index offset and palette bank per source row
+        compositeScaled(framebuffer_, width_, height_,
+                        static_cast<int>(pos.x), static_cast<int>(pos.y),
+                        static_cast<int>(width * scale), static_cast<int>(buffer.getHeight() * scale),
+                        width, buffer.getHeight(), toOpacity(opacity),
+                        [&buffer, indices, effects, width](int sx, int sy) -> const Color& {
+                            const ScanlineEffect& effect = effects[sy];
+                            int x = (sx - effect.scrollX) % width;
+                            x += x < 0 ? width : 0;
+                            uint8_t index = static_cast<uint8_t>(indices[sy * width + x] + effect.paletteOffset);
+                            return buffer.getPaletteBankData(effect.paletteBank)[index];
+                        });
+    } else {
+        compositeScaled(framebuffer_, width_, height_,
+                        static_cast<int>(pos.x), static_cast<int>(pos.y),
+                        static_cast<int>(width * scale), static_cast<int>(buffer.getHeight() * scale),
+                        width, buffer.getHeight(), toOpacity(opacity),
+                        [indices, palette, width](int sx, int sy) -> const Color& {
+                            return palette[indices[sy * width + sx]];
+                        });
+    }
+
+    auto& mutableBuffer = const_cast<IndexedPixelBuffer&>(buffer);
+    mutableBuffer.markPixelsClean();
+    mutableBuffer.markPaletteClean();
+    mutableBuffer.markScanlineEffectsClean();
+    mutableBuffer.markClean();
+}
+
+void HeadlessRenderer::drawTextureRect(const HeadlessTexture& texture,
+                                       int srcX, int srcY, int srcW, int srcH,
+                                       int dstX, int dstY, int dstW, int dstH,
+                                       float rotation, int opacity) {
+    // Clamp the source rectangle to the texture
+    int sx0 = std::max(srcX, 0);
+    int sy0 = std::max(srcY, 0);
+    int sx1 = std::min(srcX + srcW, texture.width);
+    int sy1 = std::min(srcY + srcH, texture.height);
+    if (sx0 >= sx1 || sy0 >= sy1 || dstW <= 0 || dstH <= 0) {
+        return;
+    }
+
+    countQuad(&texture);
+    const Color* pixels = texture.pixels.data();
+    int texWidth = texture.width;
+
+    if (rotation == 0.0f) {
+        compositeScaled(framebuffer_, width_, height_, dstX, dstY, dstW, dstH,
+                        srcW, srcH, opacity,
+                        [=](int sx, int sy) -> Color {
+                            int tx = srcX + sx;
+                            int ty = srcY + sy;
+                            if (tx < sx0 || tx >= sx1 || ty < sy0 || ty >= sy1) {
+                                return Color{0, 0, 0, 0};
+                            }
+                            return pixels[ty * texWidth + tx];
+                        });
+        return;
+    }
+
+    // Rotated path: clockwise rotation in degrees around the destination center,
+    // matching SDL_RenderCopyEx. Walk the rotated bounding box and map each
+    // framebuffer pixel back into the unrotated destination rectangle.
+    float radians = rotation * 3.14159265358979f / 180.0f;
+    float cosA = std::cos(radians);
+    float sinA = std::sin(radians);
+    float cx = static_cast<float>(dstX + dstW / 2);
+    float cy = static_cast<float>(dstY + dstH / 2);
+
+    float halfExtentX = (std::abs(cosA) * dstW + std::abs(sinA) * dstH) * 0.5f;
+    float halfExtentY = (std::abs(sinA) * dstW + std::abs(cosA) * dstH) * 0.5f;
+    int x0 = std::max(static_cast<int>(std::floor(cx - halfExtentX)) - 1, 0);
+    int y0 = std::max(static_cast<int>(std::floor(cy - halfExtentY)) - 1, 0);
+    int x1 = std::min(static_cast<int>(std::ceil(cx + halfExtentX)) + 1, width_);
+    int y1 = std::min(static_cast<int>(std::ceil(cy + halfExtentY)) + 1, height_);
+
+    for (int y = y0; y < y1; ++y) {
+        float ry = (y + 0.5f) - cy;
+        for (int x = x0; x < x1; ++x) {
+            float rx = (x + 0.5f) - cx;
+
+            // Inverse rotation back into destination space
+            float ux = rx * cosA + ry * sinA + (cx - dstX);
+            float uy = -rx * sinA + ry * cosA + (cy - dstY);
+            if (ux < 0.0f || uy < 0.0f || ux >= dstW || uy >= dstH) {
+                continue;
+            }
+
+            int tx = srcX + static_cast<int>(ux * srcW / dstW);
+            int ty = srcY + static_cast<int>(uy * srcH / dstH);
+            if (tx < sx0 || tx >= sx1 || ty < sy0 || ty >= sy1) {
+                continue;
+            }
+
+            blendOver(framebuffer_[y * width_ + x], pixels[ty * texWidth + tx], opacity);
+        }
+    }
+}
+
+TexturePtr HeadlessRenderer::createStreamingTexture(int width, int height) {
+    if (width <= 0 || height <= 0) {
+        return nullptr;
+    }
+
+    auto* texData = new HeadlessTexture();
+    texData->width = width;
+    texData->height = height;
+    texData->pixels.assign(static_cast<size_t>(width) * height, Color{0, 0, 0, 0});
+
+    auto texture = std::make_shared<Texture>();
+    texture->setHandle(texData, [](void* handle) {
+        delete static_cast<HeadlessTexture*>(handle);
+    });
+    texture->setDimensions(width, height);
+
+    return texture;
+}
+
+void HeadlessRenderer::updateTexture(Texture& texture, const Color* pixels, int width, int height) {
+    PROFILE_ZONE("HeadlessRenderer::updateTexture");
+    auto* texData = static_cast<HeadlessTexture*>(texture.getHandle());
+    if (!texData || width != texData->width || height != texData->height) {
+        return;
+    }
+
+    std::copy(pixels, pixels + static_cast<size_t>(width) * height, texData->pixels.begin());
+    countUpload(static_cast<uint64_t>(width) * height * sizeof(Color));
+}
+
+bool HeadlessRenderer::updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) {
+    PROFILE_ZONE("HeadlessRenderer::updateTextureRegion");
+    auto* texData = static_cast<HeadlessTexture*>(texture.getHandle());
+    if (!texData || x < 0 || y < 0 || x + width > texData->width || y + height > texData->height) {
+        return false;
+    }
+
+    for (int row = 0; row < height; ++row) {
+        std::copy_n(pixels + static_cast<size_t>(row) * width, width,
+                    texData->pixels.begin() + static_cast<size_t>(y + row) * texData->width + x);
+    }
+    countUpload(static_cast<uint64_t>(width) * height * sizeof(Color));
+    return true;
+}
+
+bool HeadlessRenderer::loadTextureFromFile(Texture& texture, const std::string& path) {
+    SDL_Surface* surface = IMG_Load(path.c_str());
+    if (!surface) {
+        std::cerr << "Failed to load image " << path << ": " << IMG_GetError() << std::endl;
+        return false;
+    }
+
+    // RGBA32 is byte-ordered R,G,B,A which matches the Color layout
+    SDL_Surface* converted = SDL_ConvertSurfaceFormat(surface, SDL_PIXELFORMAT_RGBA32, 0);
+    SDL_FreeSurface(surface);
+    if (!converted) {
+        std::cerr << "Failed to convert image " << path << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    auto* texData = new HeadlessTexture();
+    texData->width = converted->w;
+    texData->height = converted->h;
+    texData->pixels.resize(static_cast<size_t>(converted->w) * converted->h);
+
+    SDL_LockSurface(converted);
+    for (int y = 0; y < converted->h; ++y) {
+        const auto* row = reinterpret_cast<const Color*>(
+            static_cast<const uint8_t*>(converted->pixels) + y * converted->pitch);
+        std::copy(row, row + converted->w, texData->pixels.begin() + y * converted->w);
+    }
+    SDL_UnlockSurface(converted);
+    SDL_FreeSurface(converted);
+
+    texture.setHandle(texData, [](void* handle) {
+        delete static_cast<HeadlessTexture*>(handle);
+    });
+    texture.setDimensions(texData->width, texData->height);
+    return true;
+}
+
+bool HeadlessRenderer::saveToFile(const std::string& path) const {
+    if (framebuffer_.empty()) {
+        return false;
+    }
+
+    SDL_Surface* surface = SDL_CreateRGBSurfaceWithFormatFrom(
+        const_cast<Color*>(framebuffer_.data()), width_, height_, 32,
+        width_ * static_cast<int>(sizeof(Color)), SDL_PIXELFORMAT_RGBA32);
+    if (!surface) {
+        std::cerr << "Failed to create surface for " << path << ": " << SDL_GetError() << std::endl;
+        return false;
+    }
+
+    bool ok = IMG_SavePNG(surface, path.c_str()) == 0;
+    if (!ok) {
+        std::cerr << "Failed to save framebuffer to " << path << ": " << IMG_GetError() << std::endl;
+    }
+    SDL_FreeSurface(surface);
+    return ok;
+}
+
+} // namespace Engine
@@ -1,23 +1,29 @@
 #include "engine/IndexedPixelBuffer.h"
 #include "engine/IRenderer.h"
+#include "engine/MappedFile.h"
+#include "engine/PixelKernels.h"
+#include "engine/Profiler.h"
 #include <SDL_image.h>
 #include <algorithm>
 #include <vector>
 #include <iostream>
+#include <atomic>
+#include <cctype>
 #include <cmath>
+#include <cstring>
+#include <fstream>
 
 namespace Engine {
 
 IndexedPixelBuffer::IndexedPixelBuffer(int width, int height)
     : width_(width)
     , height_(height)
-    , pixels_(width * height, 0) {
+    , pixels_(width * height, 0)
+    , dirtyMaxX_(width - 1)
+    , dirtyMaxY_(height - 1) {
 
     // Initialize with a default grayscale palette
-    for (int i = 0; i < 256; ++i) {
-        uint8_t gray = static_cast<uint8_t>(i);
-        palette_[i] = Color{gray, gray, gray, 255};
-    }
+    palette_ = Palette::createGrayscale();
 }
 
 void IndexedPixelBuffer::setPixel(int x, int y, uint8_t paletteIndex) {
@@ -25,7 +31,7 @@ void IndexedPixelBuffer::setPixel(int x, int y, uint8_t paletteIndex) {
         return;  // Out of bounds
     }
     pixels_[y * width_ + x] = paletteIndex;
-    markPixelsDirty();
+    markPixelDirty(x, y);
 }
 
 uint8_t IndexedPixelBuffer::getPixel(int x, int y) const {
@@ -35,83 +41,634 @@ uint8_t IndexedPixelBuffer::getPixel(int x, int y) const {
     return pixels_[y * width_ + x];
 }
 
-void IndexedPixelBuffer::drawLine(int x0, int y0, int x1, int y1, uint8_t paletteIndex) {
-    // Bresenham's line algorithm
-    int dx = std::abs(x1 - x0);
-    int dy = std::abs(y1 - y0);
-    int sx = (x0 < x1) ? 1 : -1;
-    int sy = (y0 < y1) ? 1 : -1;
-    int err = dx - dy;
+void IndexedPixelBuffer::readRow(int y, uint8_t* dest, int x, int count) const {
+    if (count < 0) {
+        count = width_ - x;
+    }
+    if (count <= 0) {
+        return;
+    }
+    if (y < 0 || y >= height_) {
+        std::fill_n(dest, count, uint8_t{0});
+        return;
+    }
+
+    // Clip the span, zero-filling whatever falls outside the row
+    int x1 = std::max(0, x);
+    int x2 = std::min(width_, x + count);
+    if (x1 >= x2) {
+        std::fill_n(dest, count, uint8_t{0});
+        return;
+    }
+    std::fill_n(dest, x1 - x, uint8_t{0});
+    std::copy_n(&pixels_[y * width_ + x1], x2 - x1, dest + (x1 - x));
+    std::fill_n(dest + (x2 - x), x + count - x2, uint8_t{0});
+}
+
+void IndexedPixelBuffer::writeRow(int y, const uint8_t* src, int x, int count) {
+    if (count < 0) {
+        count = width_ - x;
+    }
+    if (y < 0 || y >= height_) {
+        return;
+    }
+
+    int x1 = std::max(0, x);
+    int x2 = std::min(width_, x + count);
+    if (x1 >= x2) {
+        return;
+    }
+    std::copy_n(src + (x1 - x), x2 - x1, &pixels_[y * width_ + x1]);
+    markPixelsDirty(x1, y, x2 - x1, 1);
+}
+
+void IndexedPixelBuffer::markPixelsDirty(int x, int y, int width, int height) {
+    if (doubleBuffered_) {
+        return;  // Back-buffer writes reach the screen through swap()
+    }
+
+    int x1 = std::max(0, x);
+    int y1 = std::max(0, y);
+    int x2 = std::min(width_, x + width) - 1;
+    int y2 = std::min(height_, y + height) - 1;
+    if (x1 > x2 || y1 > y2) {
+        return;
+    }
+
+    if (!pixelsDirty_) {
+        dirtyMinX_ = x1;
+        dirtyMinY_ = y1;
+        dirtyMaxX_ = x2;
+        dirtyMaxY_ = y2;
+        pixelsDirty_ = true;
+    } else {
+        dirtyMinX_ = std::min(dirtyMinX_, x1);
+        dirtyMinY_ = std::min(dirtyMinY_, y1);
+        dirtyMaxX_ = std::max(dirtyMaxX_, x2);
+        dirtyMaxY_ = std::max(dirtyMaxY_, y2);
+    }
+    dirty_ = true;
+}
+
+void IndexedPixelBuffer::markAllPixelsDirty() {
+    dirtyMinX_ = 0;
+    dirtyMinY_ = 0;
+    dirtyMaxX_ = width_ - 1;
+    dirtyMaxY_ = height_ - 1;
+    pixelsDirty_ = true;
+    dirty_ = true;
+}
+
+void IndexedPixelBuffer::setDoubleBuffered(bool enabled) {
+    if (enabled == doubleBuffered_) {
+        return;
+    }
+    if (enabled) {
+        frontPixels_ = pixels_;
+    } else {
+        // Keep what is on screen and release the second buffer
+        pixels_.swap(frontPixels_);
+        frontPixels_.clear();
+        frontPixels_.shrink_to_fit();
+    }
+    doubleBuffered_ = enabled;
+    markAllPixelsDirty();
+}
+
+void IndexedPixelBuffer::swap() {
+    if (!doubleBuffered_) {
+        return;
+    }
+    // The new front may differ anywhere from what was last uploaded
+    pixels_.swap(frontPixels_);
+    markAllPixelsDirty();
+}
+
+namespace {
+
+// Triangle vertices are snapped to 1/16 pixel; edge functions are evaluated at
+// pixel centers in the same fixed-point space with 64-bit integer math.
+constexpr int kSubpixelBits = 4;
+constexpr int64_t kSubpixelOne = int64_t{1} << kSubpixelBits;
+constexpr int64_t kSubpixelHalf = kSubpixelOne / 2;
+constexpr float kMaxCoordinate = 1 << 20;  // Keeps edge products well inside int64
+
+int64_t toFixed(float v) {
+    v = std::max(-kMaxCoordinate, std::min(kMaxCoordinate, v));
+    return static_cast<int64_t>(std::lround(v * static_cast<float>(kSubpixelOne)));
+}
+
+// Floor division with a non-negative remainder (d > 0)
+void floorDivMod(int64_t n, int64_t d, int64_t& q, int64_t& r) {
+    q = n / d;
+    r = n % d;
+    if (r < 0) {
+        r += d;
+        --q;
+    }
+}
+
+// floor(n / d) where n grows by a constant every scanline - one division at
+// setup, then a quotient/remainder step per row (no per-row divide)
+struct EdgeBound {
+    int64_t value = 0, remainder = 0;
+    int64_t stepValue = 0, stepRemainder = 0;
+    int64_t divisor = 1;
+
+    void init(int64_t n, int64_t stepN, int64_t d) {
+        divisor = d;
+        floorDivMod(n, d, value, remainder);
+        floorDivMod(stepN, d, stepValue, stepRemainder);
+    }
+
+    void step() {
+        value += stepValue;
+        remainder += stepRemainder;
+        if (remainder >= divisor) {
+            remainder -= divisor;
+            ++value;
+        }
+    }
+};
+
+// floor(n / d) and ceil(n / d) for d > 0
+int64_t floorDiv(int64_t n, int64_t d) {
+    int64_t q, r;
+    floorDivMod(n, d, q, r);
+    return q;
+}
+
+int64_t ceilDiv(int64_t n, int64_t d) {
+    return -floorDiv(-n, d);
+}
+
+// Line endpoints beyond this are pre-clipped in floating point so the exact
+// integer clipping below cannot overflow int64
+constexpr int kMaxLineCoordinate = 1 << 29;
+
+// Pixel containing a sub-pixel position (pixel (x, y) covers [x, x+1) x [y, y+1))
+int toPixel(float v) {
+    constexpr float limit = static_cast<float>(kMaxLineCoordinate);
+    v = std::max(-limit, std::min(limit, v));
+    return static_cast<int>(std::floor(v));
+}
+
+// Steps k (coordinate = start + dir * k) that land inside [0, limit)
+void visibleSteps(int start, int dir, int limit, int64_t& lo, int64_t& hi) {
+    if (dir > 0) {
+        lo = -static_cast<int64_t>(start);
+        hi = static_cast<int64_t>(limit) - 1 - start;
+    } else {
+        lo = static_cast<int64_t>(start) - (limit - 1);
+        hi = start;
+    }
+}
 
-    while (true) {
-        setPixel(x0, y0, paletteIndex);
+// Translucent span: each pixel goes through one source row of a blend table
+void blendSpan(uint8_t* dest, size_t count, const uint8_t* lookup) {
+    for (size_t i = 0; i < count; ++i) {
+        dest[i] = lookup[dest[i]];
+    }
+}
+
+} // anonymous namespace
 
-        if (x0 == x1 && y0 == y1) {
-            break;
+void IndexedPixelBuffer::drawLine(int x0, int y0, int x1, int y1, uint8_t paletteIndex) {
+    // Cohen-Sutherland trivial reject: both endpoints beyond the same edge
+    auto outcode = [this](int x, int y) {
+        return (x < 0 ? 1 : 0) | (x >= width_ ? 2 : 0) | (y < 0 ? 4 : 0) | (y >= height_ ? 8 : 0);
+    };
+    if (outcode(x0, y0) & outcode(x1, y1)) {
+        return;
+    }
+
+    // Horizontal and vertical fast paths
+    if (y0 == y1) {
+        int left = std::max(0, std::min(x0, x1));
+        int right = std::min(width_ - 1, std::max(x0, x1));
+        std::memset(pixels_.data() + static_cast<size_t>(y0) * width_ + left, paletteIndex,
+                    static_cast<size_t>(right - left + 1));
+        markPixelsDirty(left, y0, right - left + 1, 1);
+        return;
+    }
+    if (x0 == x1) {
+        int top = std::max(0, std::min(y0, y1));
+        int bottom = std::min(height_ - 1, std::max(y0, y1));
+        uint8_t* p = pixels_.data() + static_cast<size_t>(top) * width_ + x0;
+        for (int y = top; y <= bottom; ++y, p += width_) {
+            *p = paletteIndex;
         }
+        markPixelsDirty(x0, top, 1, bottom - top + 1);
+        return;
+    }
 
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
+    // Far-off endpoints: shrink the segment to a guard band around the buffer
+    // first (Liang-Barsky), keeping the exact integer math below in range
+    if (std::max({std::abs(static_cast<int64_t>(x0)), std::abs(static_cast<int64_t>(y0)),
+                  std::abs(static_cast<int64_t>(x1)), std::abs(static_cast<int64_t>(y1))}) > kMaxLineCoordinate) {
+        double dx = static_cast<double>(x1) - x0;
+        double dy = static_cast<double>(y1) - y0;
+        double t0 = 0.0, t1 = 1.0;
+        const double guard = 1 << 16;
+        const double p[4] = {-dx, dx, -dy, dy};
+        const double q[4] = {x0 + guard, width_ + guard - x0, y0 + guard, height_ + guard - y0};
+        for (int i = 0; i < 4; ++i) {
+            if (p[i] == 0.0) {
+                if (q[i] < 0.0) return;
+                continue;
+            }
+            double t = q[i] / p[i];
+            if (p[i] < 0.0) {
+                t0 = std::max(t0, t);
+            } else {
+                t1 = std::min(t1, t);
+            }
         }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+        if (t0 > t1) {
+            return;
         }
+        int cx0 = static_cast<int>(std::lround(x0 + t0 * dx));
+        int cy0 = static_cast<int>(std::lround(y0 + t0 * dy));
+        int cx1 = static_cast<int>(std::lround(x0 + t1 * dx));
+        int cy1 = static_cast<int>(std::lround(y0 + t1 * dy));
+        drawLine(cx0, cy0, cx1, cy1, paletteIndex);
+        return;
+    }
+
+    // Bresenham along the major axis: after k major steps the minor offset is
+    // m(k) = floor((2*k*minor + major) / (2*major)). Both axes' visible ranges
+    // are solved for k directly, so off-buffer parts of the line cost nothing.
+    const bool xMajor = std::abs(x1 - x0) >= std::abs(y1 - y0);
+    const int majorStart = xMajor ? x0 : y0;
+    const int minorStart = xMajor ? y0 : x0;
+    const int majorEnd = xMajor ? x1 : y1;
+    const int minorEnd = xMajor ? y1 : x1;
+    const int majorDir = majorEnd > majorStart ? 1 : -1;
+    const int minorDir = minorEnd > minorStart ? 1 : -1;
+    const int64_t major = std::abs(static_cast<int64_t>(majorEnd) - majorStart);
+    const int64_t minor = std::abs(static_cast<int64_t>(minorEnd) - minorStart);
+    const int64_t twoMajor = 2 * major;
+    const int64_t twoMinor = 2 * minor;
+
+    int64_t kLo = 0, kHi = major;
+    int64_t lo, hi;
+    visibleSteps(majorStart, majorDir, xMajor ? width_ : height_, lo, hi);
+    kLo = std::max(kLo, lo);
+    kHi = std::min(kHi, hi);
+
+    visibleSteps(minorStart, minorDir, xMajor ? height_ : width_, lo, hi);
+    // m(k) >= lo  <=>  2*k*minor + major >= 2*major*lo
+    kLo = std::max(kLo, ceilDiv(twoMajor * lo - major, twoMinor));
+    // m(k) <= hi  <=>  2*k*minor + major < 2*major*(hi + 1)
+    kHi = std::min(kHi, floorDiv(twoMajor * (hi + 1) - major - 1, twoMinor));
+    if (kLo > kHi) {
+        return;
+    }
+
+    int64_t m, remainder;
+    floorDivMod(twoMinor * kLo + major, twoMajor, m, remainder);
+    const int64_t mLast = floorDiv(twoMinor * kHi + major, twoMajor);
+
+    const ptrdiff_t majorStep = xMajor ? majorDir : static_cast<ptrdiff_t>(majorDir) * width_;
+    const ptrdiff_t minorStep = xMajor ? static_cast<ptrdiff_t>(minorDir) * width_ : minorDir;
+    int firstMajor = majorStart + majorDir * static_cast<int>(kLo);
+    int firstMinor = minorStart + minorDir * static_cast<int>(m);
+    int lastMajor = majorStart + majorDir * static_cast<int>(kHi);
+    int lastMinor = minorStart + minorDir * static_cast<int>(mLast);
+    int startX = xMajor ? firstMajor : firstMinor;
+    int startY = xMajor ? firstMinor : firstMajor;
+    int endX = xMajor ? lastMajor : lastMinor;
+    int endY = xMajor ? lastMinor : lastMajor;
+
+    uint8_t* p = pixels_.data() + static_cast<ptrdiff_t>(startY) * width_ + startX;
+    for (int64_t k = kLo; k <= kHi; ++k) {
+        *p = paletteIndex;
+        p += majorStep;
+        remainder += twoMinor;
+        if (remainder >= twoMajor) {
+            remainder -= twoMajor;
+            p += minorStep;
+        }
+    }
+
+    markPixelsDirty(std::min(startX, endX), std::min(startY, endY),
+                    std::abs(endX - startX) + 1, std::abs(endY - startY) + 1);
+}
+
+void IndexedPixelBuffer::drawLine(const Vec2& p0, const Vec2& p1, uint8_t paletteIndex) {
+    drawLine(toPixel(p0.x), toPixel(p0.y), toPixel(p1.x), toPixel(p1.y), paletteIndex);
+}
+
+void IndexedPixelBuffer::drawPolyline(const Vec2* points, size_t count, uint8_t paletteIndex, bool closed) {
+    if (count < 2) {
+        return;
+    }
+
+    // Convert each shared vertex once
+    int firstX = toPixel(points[0].x);
+    int firstY = toPixel(points[0].y);
+    int prevX = firstX;
+    int prevY = firstY;
+    for (size_t i = 1; i < count; ++i) {
+        int x = toPixel(points[i].x);
+        int y = toPixel(points[i].y);
+        drawLine(prevX, prevY, x, y, paletteIndex);
+        prevX = x;
+        prevY = y;
+    }
+    if (closed && count > 2) {
+        drawLine(prevX, prevY, firstX, firstY, paletteIndex);
+    }
+}
+
+void IndexedPixelBuffer::drawLines(const Vec2* points, size_t count, uint8_t paletteIndex) {
+    for (size_t i = 0; i + 1 < count; i += 2) {
+        drawLine(points[i], points[i + 1], paletteIndex);
     }
 }
 
 void IndexedPixelBuffer::fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint8_t paletteIndex) {
-    // Sort vertices by Y coordinate (y0 <= y1 <= y2)
-    if (y1 < y0) { std::swap(x0, x1); std::swap(y0, y1); }
-    if (y2 < y0) { std::swap(x0, x2); std::swap(y0, y2); }
-    if (y2 < y1) { std::swap(x1, x2); std::swap(y1, y2); }
+    // Integer coordinates address pixels - place each vertex at its pixel center
+    auto fixed = [](int v) { return static_cast<int64_t>(v) * kSubpixelOne + kSubpixelHalf; };
+    rasterizeTriangle(fixed(x0), fixed(y0), fixed(x1), fixed(y1), fixed(x2), fixed(y2), paletteIndex);
+}
 
-    // Handle degenerate cases
-    if (y0 == y2) return;  // All vertices on same horizontal line
+void IndexedPixelBuffer::fillTriangle(const Vec2& p0, const Vec2& p1, const Vec2& p2, uint8_t paletteIndex) {
+    rasterizeTriangle(toFixed(p0.x), toFixed(p0.y), toFixed(p1.x), toFixed(p1.y),
+                      toFixed(p2.x), toFixed(p2.y), paletteIndex);
+}
 
-    // Fill the triangle using scanline algorithm
-    auto fillScanline = [this, paletteIndex](int y, int x_start, int x_end) {
-        if (x_start > x_end) std::swap(x_start, x_end);
-        for (int x = x_start; x <= x_end; ++x) {
-            setPixel(x, y, paletteIndex);
-        }
-    };
+void IndexedPixelBuffer::fillTriangle(int x0, int y0, int x1, int y1, int x2, int y2, uint8_t paletteIndex,
+                                      const BlendTable& blend) {
+    auto fixed = [](int v) { return static_cast<int64_t>(v) * kSubpixelOne + kSubpixelHalf; };
+    rasterizeTriangle(fixed(x0), fixed(y0), fixed(x1), fixed(y1), fixed(x2), fixed(y2), paletteIndex, &blend);
+}
+
+void IndexedPixelBuffer::fillTriangle(const Vec2& p0, const Vec2& p1, const Vec2& p2, uint8_t paletteIndex,
+                                      const BlendTable& blend) {
+    rasterizeTriangle(toFixed(p0.x), toFixed(p0.y), toFixed(p1.x), toFixed(p1.y),
+                      toFixed(p2.x), toFixed(p2.y), paletteIndex, &blend);
+}
+
+void IndexedPixelBuffer::rasterizeTriangle(int64_t x0, int64_t y0, int64_t x1, int64_t y1,
+                                           int64_t x2, int64_t y2, uint8_t paletteIndex, const BlendTable* blend) {
+    // Orient so the interior is where all three edge functions are >= 0
+    int64_t area = (x1 - x0) * (y2 - y0) - (y1 - y0) * (x2 - x0);
+    if (area == 0) {
+        return;  // Degenerate
+    }
+    if (area < 0) {
+        std::swap(x1, x2);
+        std::swap(y1, y2);
+    }
 
-    // Interpolate X coordinates for each scanline
-    for (int y = y0; y <= y2; ++y) {
-        // Calculate X coordinates on the two edges at this Y
-        int x_a, x_b;
+    // Rows whose pixel centers fall inside the vertical extent, clipped once
+    int64_t minY = std::min({y0, y1, y2});
+    int64_t maxY = std::max({y0, y1, y2});
+    int64_t q, r;
+    floorDivMod(minY - kSubpixelHalf + kSubpixelOne - 1, kSubpixelOne, q, r);
+    int rowStart = static_cast<int>(std::max<int64_t>(q, 0));
+    floorDivMod(maxY - kSubpixelHalf, kSubpixelOne, q, r);
+    int rowEnd = static_cast<int>(std::min<int64_t>(q, height_ - 1));
+    if (rowStart > rowEnd) {
+        return;
+    }
 
-        // Long edge (from y0 to y2)
-        if (y2 > y0) {
-            float t = static_cast<float>(y - y0) / (y2 - y0);
-            x_a = static_cast<int>(x0 + t * (x2 - x0));
+    // Each edge E(px, py) = (xb - xa) * (py - ya) - (yb - ya) * (px - xa) turns into
+    // a bound on the pixel column: edges going up bound the span on the left,
+    // edges going down on the right. Top-left rule: pixel centers exactly on a
+    // top or left edge are inside, on a bottom or right edge outside - shared
+    // edges are drawn exactly once.
+    EdgeBound lower[3], upper[3];
+    int lowerCount = 0, upperCount = 0;
+    int64_t flatEdge[3];          // Horizontal edges: E per row (constant along x)
+    int64_t flatStep[3];
+    int flatCount = 0;
+
+    const int64_t xs[3] = {x0, x1, x2};
+    const int64_t ys[3] = {y0, y1, y2};
+    int64_t rowCenter = static_cast<int64_t>(rowStart) * kSubpixelOne + kSubpixelHalf;
+
+    for (int i = 0; i < 3; ++i) {
+        int64_t xa = xs[i], ya = ys[i];
+        int64_t xb = xs[(i + 1) % 3], yb = ys[(i + 1) % 3];
+        int64_t dx = xb - xa;
+        int64_t dy = yb - ya;
+
+        bool topLeft = dy < 0 || (dy == 0 && dx > 0);
+        int64_t bias = topLeft ? 0 : -1;
+
+        // E at the center of pixel column 0 on the first row, and its steps
+        int64_t e = dx * (rowCenter - ya) - dy * (kSubpixelHalf - xa) + bias;
+        int64_t stepX = -dy * kSubpixelOne;  // Per column
+        int64_t stepY = dx * kSubpixelOne;   // Per row
+
+        if (stepX > 0) {
+            // e + stepX * x >= 0  ->  x >= ceil(-e / stepX)
+            lower[lowerCount++].init(-e + stepX - 1, -stepY, stepX);
+        } else if (stepX < 0) {
+            // e + stepX * x >= 0  ->  x <= floor(e / -stepX)
+            upper[upperCount++].init(e, stepY, -stepX);
         } else {
-            x_a = x0;
+            flatEdge[flatCount] = e;
+            flatStep[flatCount++] = stepY;
+        }
+    }
+
+    int dirtyMinX = width_, dirtyMaxX = -1;
+    int dirtyMinY = height_, dirtyMaxY = -1;
+
+    for (int y = rowStart; y <= rowEnd; ++y) {
+        bool inside = true;
+        for (int i = 0; i < flatCount; ++i) {
+            inside = inside && flatEdge[i] >= 0;
+            flatEdge[i] += flatStep[i];
+        }
+
+        int64_t left = 0;
+        int64_t right = width_ - 1;
+        for (int i = 0; i < lowerCount; ++i) {
+            left = std::max(left, lower[i].value);
+            lower[i].step();
+        }
+        for (int i = 0; i < upperCount; ++i) {
+            right = std::min(right, upper[i].value);
+            upper[i].step();
         }
 
-        // Short edge (either y0-y1 or y1-y2)
-        if (y < y1) {
-            // Top half: interpolate between y0 and y1
-            if (y1 > y0) {
-                float t = static_cast<float>(y - y0) / (y1 - y0);
-                x_b = static_cast<int>(x0 + t * (x1 - x0));
+        if (inside && left <= right) {
+            int x1Span = static_cast<int>(left);
+            int x2Span = static_cast<int>(right);
+            size_t count = static_cast<size_t>(x2Span - x1Span + 1);
+            if (blend) {
+                blendSpan(&pixels_[y * width_ + x1Span], count, blend->row(paletteIndex));
             } else {
-                x_b = x0;
+                std::memset(&pixels_[y * width_ + x1Span], paletteIndex, count);
             }
-        } else {
-            // Bottom half: interpolate between y1 and y2
-            if (y2 > y1) {
-                float t = static_cast<float>(y - y1) / (y2 - y1);
-                x_b = static_cast<int>(x1 + t * (x2 - x1));
-            } else {
-                x_b = x1;
+            dirtyMinX = std::min(dirtyMinX, x1Span);
+            dirtyMaxX = std::max(dirtyMaxX, x2Span);
+            dirtyMinY = std::min(dirtyMinY, y);
+            dirtyMaxY = y;
+        }
+    }
+
+    if (dirtyMaxX >= 0) {
+        markPixelsDirty(dirtyMinX, dirtyMinY, dirtyMaxX - dirtyMinX + 1, dirtyMaxY - dirtyMinY + 1);
+    }
+}
+
+void IndexedPixelBuffer::fillPolygon(const Vec2* points, size_t count, uint8_t paletteIndex, FillRule rule) {
+    rasterizePolygon(points, count, paletteIndex, rule, nullptr);
+}
+
+void IndexedPixelBuffer::fillPolygon(const Vec2* points, size_t count, uint8_t paletteIndex, const BlendTable& blend,
+                                     FillRule rule) {
+    rasterizePolygon(points, count, paletteIndex, rule, &blend);
+}
+
+void IndexedPixelBuffer::rasterizePolygon(const Vec2* points, size_t count, uint8_t paletteIndex, FillRule rule,
+                                          const BlendTable* blend) {
+    if (!points || count < 3) {
+        return;
+    }
+    if (count == 3) {
+        // Both rules agree on a triangle, and the edge-function rasterizer covers
+        // the same pixels without building an edge table
+        rasterizeTriangle(toFixed(points[0].x), toFixed(points[0].y), toFixed(points[1].x), toFixed(points[1].y),
+                          toFixed(points[2].x), toFixed(points[2].y), paletteIndex, blend);
+        return;
+    }
+
+    // Edge table: every non-horizontal edge, oriented downwards and clipped to
+    // the rows whose pixel centers it spans. Top endpoints are inclusive and
+    // bottom ones exclusive, so a vertex shared by two edges is crossed once
+    // per row and horizontal edges follow the top-left rule on their own.
+    std::vector<PolygonEdge>& edges = polygonEdges_;
+    edges.clear();
+    int64_t prevX = toFixed(points[count - 1].x);
+    int64_t prevY = toFixed(points[count - 1].y);
+    for (size_t i = 0; i < count; ++i) {
+        int64_t xa = prevX, ya = prevY;
+        int64_t xb = toFixed(points[i].x), yb = toFixed(points[i].y);
+        prevX = xb;
+        prevY = yb;
+        if (ya == yb) {
+            continue;
+        }
+        int winding = 1;
+        if (ya > yb) {
+            std::swap(xa, xb);
+            std::swap(ya, yb);
+            winding = -1;
+        }
+
+        int64_t rowStart = std::max<int64_t>(ceilDiv(ya - kSubpixelHalf, kSubpixelOne), 0);
+        int64_t rowEnd = std::min<int64_t>(ceilDiv(yb - kSubpixelHalf, kSubpixelOne), height_);
+        if (rowStart >= rowEnd) {
+            continue;
+        }
+
+        // Pixel column x is right of the crossing when its center x * 16 + 8 is at
+        // or past xa + (rowCenter - ya) * dx / dy; the first such column is a
+        // ceiling division that steps by dx * 16 / dy per row
+        int64_t dx = xb - xa;
+        int64_t dy = yb - ya;
+        int64_t rowCenter = rowStart * kSubpixelOne + kSubpixelHalf;
+        PolygonEdge edge;
+        edge.divisor = dy * kSubpixelOne;
+        floorDivMod((xa - kSubpixelHalf) * dy + (rowCenter - ya) * dx + edge.divisor - 1, edge.divisor,
+                    edge.column, edge.remainder);
+        floorDivMod(dx * kSubpixelOne, edge.divisor, edge.stepColumn, edge.stepRemainder);
+        edge.rowStart = static_cast<int>(rowStart);
+        edge.rowEnd = static_cast<int>(rowEnd);
+        edge.winding = winding;
+        edges.push_back(edge);
+    }
+    if (edges.empty()) {
+        return;
+    }
+    std::sort(edges.begin(), edges.end(),
+              [](const PolygonEdge& a, const PolygonEdge& b) { return a.rowStart < b.rowStart; });
+
+    auto inside = [rule](int winding) {
+        return rule == FillRule::NonZero ? winding != 0 : (winding & 1) != 0;
+    };
+
+    std::vector<uint32_t>& active = activeEdges_;
+    active.clear();
+    size_t nextEdge = 0;
+    int nextEnd = 0;  // First row at which an active edge ends
+    int dirtyMinX = width_, dirtyMaxX = -1;
+    int dirtyMinY = height_, dirtyMaxY = -1;
+
+    for (int y = edges.front().rowStart;; ++y) {
+        if (y >= nextEnd) {
+            active.erase(std::remove_if(active.begin(), active.end(),
+                                        [&](uint32_t index) { return edges[index].rowEnd <= y; }),
+                         active.end());
+            nextEnd = height_;
+            for (uint32_t index : active) {
+                nextEnd = std::min(nextEnd, edges[index].rowEnd);
             }
         }
+        if (active.empty()) {
+            if (nextEdge == edges.size()) {
+                break;
+            }
+            y = edges[nextEdge].rowStart;  // Skip rows no edge crosses
+        }
+        while (nextEdge < edges.size() && edges[nextEdge].rowStart == y) {
+            nextEnd = std::min(nextEnd, edges[nextEdge].rowEnd);
+            active.push_back(static_cast<uint32_t>(nextEdge++));
+        }
 
-        fillScanline(y, x_a, x_b);
+        // Insertion sort by column - the order rarely changes from one row to the next
+        for (size_t i = 1; i < active.size(); ++i) {
+            uint32_t index = active[i];
+            size_t j = i;
+            for (; j > 0 && edges[active[j - 1]].column > edges[index].column; --j) {
+                active[j] = active[j - 1];
+            }
+            active[j] = index;
+        }
+
+        // Walk the crossings left to right; each inside run is one span
+        int winding = 0;
+        int64_t spanStart = 0;
+        for (uint32_t index : active) {
+            PolygonEdge& edge = edges[index];
+            bool wasInside = inside(winding);
+            winding += rule == FillRule::NonZero ? edge.winding : 1;
+            if (!wasInside) {
+                spanStart = edge.column;
+            } else if (!inside(winding)) {
+                int x1Span = static_cast<int>(std::max<int64_t>(spanStart, 0));
+                int x2Span = static_cast<int>(std::min<int64_t>(edge.column, width_));
+                if (x1Span < x2Span) {
+                    size_t spanCount = static_cast<size_t>(x2Span - x1Span);
+                    if (blend) {
+                        blendSpan(&pixels_[y * width_ + x1Span], spanCount, blend->row(paletteIndex));
+                    } else {
+                        std::memset(&pixels_[y * width_ + x1Span], paletteIndex, spanCount);
+                    }
+                    dirtyMinX = std::min(dirtyMinX, x1Span);
+                    dirtyMaxX = std::max(dirtyMaxX, x2Span - 1);
+                    dirtyMinY = std::min(dirtyMinY, y);
+                    dirtyMaxY = y;
+                }
+            }
+
+            edge.column += edge.stepColumn;
+            edge.remainder += edge.stepRemainder;
+            if (edge.remainder >= edge.divisor) {
+                edge.remainder -= edge.divisor;
+                ++edge.column;
+            }
+        }
+    }
+
+    if (dirtyMaxX >= 0) {
+        markPixelsDirty(dirtyMinX, dirtyMinY, dirtyMaxX - dirtyMinX + 1, dirtyMaxY - dirtyMinY + 1);
     }
 }
 
@@ -135,7 +692,157 @@ void IndexedPixelBuffer::fillRect(int x, int y, int width, int height, uint8_t p
         std::fill_n(&pixels_[offset], count, paletteIndex);
     }
 
-    markPixelsDirty();
+    markPixelsDirty(x1, y1, x2 - x1, y2 - y1);
+}
+
+void IndexedPixelBuffer::fillRect(int x, int y, int width, int height, uint8_t paletteIndex, const BlendTable& blend) {
+    int x1 = std::max(0, x);
+    int y1 = std::max(0, y);
+    int x2 = std::min(width_, x + width);
+    int y2 = std::min(height_, y + height);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    const uint8_t* lookup = blend.row(paletteIndex);
+    for (int row = y1; row < y2; ++row) {
+        blendSpan(&pixels_[row * width_ + x1], static_cast<size_t>(x2 - x1), lookup);
+    }
+
+    markPixelsDirty(x1, y1, x2 - x1, y2 - y1);
+}
+
+namespace {
+
+// Blitter row kernels, one instantiation per option combination. FlipX kernels
+// read leftwards from the rightmost source pixel of the row.
+using BlitRowFn = void (*)(const uint8_t* src, uint8_t* dest, int count, uint8_t key,
+                           const uint8_t* remap, const BlendTable* blend);
+
+template <bool Masked, bool FlipX, bool Remap, bool Blend>
+void blitRow(const uint8_t* src, uint8_t* dest, int count, uint8_t key,
+             const uint8_t* remap, const BlendTable* blend) {
+    if constexpr (!FlipX && !Remap && !Blend) {
+        if constexpr (Masked) {
+            blitMaskedIndexed(src, dest, static_cast<size_t>(count), key);
+        } else {
+            std::memcpy(dest, src, static_cast<size_t>(count));
+        }
+    } else {
+        for (int i = 0; i < count; ++i) {
+            uint8_t index = FlipX ? src[-i] : src[i];
+            if (Masked && index == key) {
+                continue;
+            }
+            if (Remap) {
+                index = remap[index];
+            }
+            dest[i] = Blend ? blend->blend(index, dest[i]) : index;
+        }
+    }
+}
+
+// Indexed by masked | flipX << 1 | remap << 2 | blend << 3
+constexpr BlitRowFn kBlitRowKernels[16] = {
+    blitRow<false, false, false, false>, blitRow<true, false, false, false>,
+    blitRow<false, true, false, false>,  blitRow<true, true, false, false>,
+    blitRow<false, false, true, false>,  blitRow<true, false, true, false>,
+    blitRow<false, true, true, false>,   blitRow<true, true, true, false>,
+    blitRow<false, false, false, true>,  blitRow<true, false, false, true>,
+    blitRow<false, true, false, true>,   blitRow<true, true, false, true>,
+    blitRow<false, false, true, true>,   blitRow<true, false, true, true>,
+    blitRow<false, true, true, true>,    blitRow<true, true, true, true>,
+};
+
+// Clips one axis of a blit. Destination offset j in [0, size) reads source
+// offset (flip ? size - 1 - j : j); returns the visible j range [first, end).
+bool clipBlitAxis(int src, int size, int srcLimit, int dest, int destLimit, bool flip, int& first, int& end) {
+    int64_t cutLow = std::max<int64_t>(0, -static_cast<int64_t>(src));
+    int64_t cutHigh = std::max<int64_t>(0, static_cast<int64_t>(src) + size - srcLimit);
+    int64_t lo = std::max<int64_t>(flip ? cutHigh : cutLow, -static_cast<int64_t>(dest));
+    int64_t hi = std::min<int64_t>(size - (flip ? cutLow : cutHigh), static_cast<int64_t>(destLimit) - dest);
+    if (lo >= hi) {
+        return false;
+    }
+    first = static_cast<int>(lo);
+    end = static_cast<int>(hi);
+    return true;
+}
+
+} // anonymous namespace
+
+void IndexedPixelBuffer::blit(const IndexedPixelBuffer& source, int srcX, int srcY, int width, int height,
+                              int destX, int destY, const BlitOptions& options) {
+    if (width <= 0 || height <= 0) {
+        return;
+    }
+
+    int colFirst, colEnd, rowFirst, rowEnd;
+    if (!clipBlitAxis(srcX, width, source.width_, destX, width_, options.flipX, colFirst, colEnd) ||
+        !clipBlitAxis(srcY, height, source.height_, destY, height_, options.flipY, rowFirst, rowEnd)) {
+        return;
+    }
+
+    const int count = colEnd - colFirst;
+    const int rows = rowEnd - rowFirst;
+    const int srcCol = options.flipX ? srcX + width - 1 - colFirst : srcX + colFirst;
+    const int srcRow = options.flipY ? srcY + height - 1 - rowFirst : srcY + rowFirst;
+
+    const uint8_t* src = source.pixels_.data() + static_cast<ptrdiff_t>(srcRow) * source.width_ + srcCol;
+    ptrdiff_t srcPitch = options.flipY ? -static_cast<ptrdiff_t>(source.width_) : source.width_;
+
+    if (&source == this) {
+        // Stage the source rows in destination order so overlapping copies read original pixels
+        int leftCol = options.flipX ? srcCol - count + 1 : srcCol;
+        blitScratch_.resize(static_cast<size_t>(count) * rows);
+        const uint8_t* row = pixels_.data() + static_cast<ptrdiff_t>(srcRow) * width_ + leftCol;
+        for (int y = 0; y < rows; ++y, row += srcPitch) {
+            std::memcpy(blitScratch_.data() + static_cast<size_t>(y) * count, row, static_cast<size_t>(count));
+        }
+        src = blitScratch_.data() + (options.flipX ? count - 1 : 0);
+        srcPitch = count;
+    }
+
+    const bool masked = options.transparentIndex >= 0 && options.transparentIndex <= 255;
+    const BlitRowFn kernel = kBlitRowKernels[(masked ? 1 : 0) | (options.flipX ? 2 : 0) |
+                                             (options.remap ? 4 : 0) | (options.blend ? 8 : 0)];
+    const uint8_t key = static_cast<uint8_t>(masked ? options.transparentIndex : 0);
+
+    uint8_t* dest = pixels_.data() + static_cast<ptrdiff_t>(destY + rowFirst) * width_ + destX + colFirst;
+    for (int y = 0; y < rows; ++y) {
+        kernel(src, dest, count, key, options.remap, options.blend);
+        src += srcPitch;
+        dest += width_;
+    }
+
+    markPixelsDirty(destX + colFirst, destY + rowFirst, count, rows);
+}
+
+void IndexedPixelBuffer::applyLightMap(const uint8_t* light, int lightPitch, int x, int y, int width, int height,
+                                       const ShadeTable& shades) {
+    if (!light) {
+        return;
+    }
+    int x1 = std::max(0, x);
+    int y1 = std::max(0, y);
+    int x2 = std::min(width_, x + width);
+    int y2 = std::min(height_, y + height);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    PROFILE_ZONE("IndexedPixelBuffer::applyLightMap");
+    const uint8_t* table = shades.getLightTable();
+    uint8_t* destBase = pixels_.data();
+    size_t count = static_cast<size_t>(x2 - x1);
+    WorkerPool::getInstance().parallelForBands(y2 - y1, count * 2, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+            int py = y1 + row;
+            shadeIndexed(destBase + static_cast<ptrdiff_t>(py) * width_ + x1,
+                         light + static_cast<ptrdiff_t>(py - y) * lightPitch + (x1 - x), table, count);
+        }
+    });
+    markPixelsDirty(x1, y1, x2 - x1, y2 - y1);
 }
 
 void IndexedPixelBuffer::clear(uint8_t paletteIndex) {
@@ -148,100 +855,259 @@ void IndexedPixelBuffer::fill(uint8_t paletteIndex) {
 }
 
 void IndexedPixelBuffer::setPaletteEntry(uint8_t index, const Color& color) {
-    palette_[index] = color;
+    palette_.setColor(index, color);
     markPaletteDirty();
 }
 
 const Color& IndexedPixelBuffer::getPaletteEntry(uint8_t index) const {
-    return palette_[index];
+    return palette_.getColor(index);
 }
 
 void IndexedPixelBuffer::setPalette(const std::array<Color, 256>& palette) {
-    palette_ = palette;
+    palette_.setColors(palette);
     markPaletteDirty();
 }
 
 void IndexedPixelBuffer::setPalette(const Color* paletteData) {
     if (!paletteData) return;
 
-    for (int i = 0; i < 256; ++i) {
-        palette_[i] = paletteData[i];
+    std::array<Color, 256> colors;
+    std::copy_n(paletteData, 256, colors.begin());
+    palette_.setColors(colors);
+    markPaletteDirty();
+}
+
+void IndexedPixelBuffer::setPaletteBankCount(int count) {
+    count = std::max(1, std::min(kMaxPaletteBanks, count));
+    size_t oldBanks = paletteBanks_.size() / 256;
+    paletteBanks_.resize(static_cast<size_t>(count - 1) * 256);
+    for (size_t bank = oldBanks; bank < paletteBanks_.size() / 256; ++bank) {
+        std::copy(palette_.getColors().begin(), palette_.getColors().end(), paletteBanks_.begin() + bank * 256);
     }
+    paletteBankCount_ = count;
     markPaletteDirty();
+    scanlineEffectsDirty_ = scanlineEffectsDirty_ || !scanlineEffects_.empty();  // Bank remapping changed
+}
+
+void IndexedPixelBuffer::setPaletteBank(int bank, const std::array<Color, 256>& palette) {
+    if (bank == 0) {
+        setPalette(palette);
+    } else if (bank > 0 && bank < paletteBankCount_) {
+        std::copy(palette.begin(), palette.end(), paletteBanks_.begin() + (bank - 1) * 256);
+        markPaletteDirty();
+    }
+}
+
+void IndexedPixelBuffer::setPaletteBankEntry(int bank, uint8_t index, const Color& color) {
+    if (bank == 0) {
+        setPaletteEntry(index, color);
+    } else if (bank > 0 && bank < paletteBankCount_) {
+        paletteBanks_[static_cast<size_t>(bank - 1) * 256 + index] = color;
+        markPaletteDirty();
+    }
+}
+
+const Color* IndexedPixelBuffer::getPaletteBankData(int bank) const {
+    if (bank <= 0 || bank >= paletteBankCount_) {
+        return getPaletteData();
+    }
+    return paletteBanks_.data() + static_cast<size_t>(bank - 1) * 256;
+}
+
+void IndexedPixelBuffer::setScanlineEffect(int y, const ScanlineEffect& effect) {
+    if (y < 0 || y >= height_) {
+        return;
+    }
+    if (scanlineEffects_.empty()) {
+        scanlineEffects_.resize(height_);
+    }
+    scanlineEffects_[y] = effect;
+    scanlineEffectsDirty_ = true;
+    dirty_ = true;
+}
+
+void IndexedPixelBuffer::setScanlineEffects(const ScanlineEffect* effects) {
+    if (!effects) return;
+
+    scanlineEffects_.assign(effects, effects + height_);
+    scanlineEffectsDirty_ = true;
+    dirty_ = true;
+}
+
+void IndexedPixelBuffer::clearScanlineEffects() {
+    if (scanlineEffects_.empty()) {
+        return;
+    }
+    scanlineEffects_.clear();
+    scanlineEffects_.shrink_to_fit();
+    scanlineEffectsDirty_ = true;  // Displayed image changes back to the plain buffer
+    dirty_ = true;
 }
 
 namespace {
-    // Helper struct for median-cut quantization
-    struct ColorBox {
-        std::vector<Color> colors;
-
-        void computeRange(int& rRange, int& gRange, int& bRange) const {
-            if (colors.empty()) {
-                rRange = gRange = bRange = 0;
-                return;
-            }
 
-            uint8_t minR = 255, maxR = 0;
-            uint8_t minG = 255, maxG = 0;
-            uint8_t minB = 255, maxB = 0;
-
-            for (const auto& c : colors) {
-                minR = std::min(minR, c.r);
-                maxR = std::max(maxR, c.r);
-                minG = std::min(minG, c.g);
-                maxG = std::max(maxG, c.g);
-                minB = std::min(minB, c.b);
-                maxB = std::max(maxB, c.b);
-            }
+// Baked indexed image layout (see IndexedPixelBuffer::loadFromIndexedFile)
+struct IndexedImageHeader {
+    char magic[4];           // "IDX8"
+    uint16_t version;
+    uint16_t compression;    // IndexedImageCompression
+    uint32_t width;
+    uint32_t height;
+    uint32_t planeSize;      // Bytes of index data after the palette
+    uint32_t reserved[3];
+};
+
+constexpr size_t kIndexedImageHeaderBytes = 32;
+constexpr char kIndexedImageMagic[4] = {'I', 'D', 'X', '8'};
+constexpr uint16_t kIndexedImageVersion = 1;
+constexpr size_t kIndexedImagePaletteBytes = 256 * sizeof(Color);
+constexpr uint32_t kIndexedImageMaxSide = 1 << 15;
+
+enum IndexedImageCompression : uint16_t {
+    kIndexedImageRaw = 0,
+    kIndexedImageRLE = 1,
+};
+
+// The file is little-endian whatever the host; byte-wise access also avoids
+// unaligned loads from the mapping
+uint16_t readLE16(const uint8_t* p) {
+    return static_cast<uint16_t>(p[0] | (p[1] << 8));
+}
 
-            rRange = maxR - minR;
-            gRange = maxG - minG;
-            bRange = maxB - minB;
-        }
+uint32_t readLE32(const uint8_t* p) {
+    return static_cast<uint32_t>(p[0]) | (static_cast<uint32_t>(p[1]) << 8) |
+           (static_cast<uint32_t>(p[2]) << 16) | (static_cast<uint32_t>(p[3]) << 24);
+}
 
-        Color getAverageColor() const {
-            if (colors.empty()) return Color{0, 0, 0, 255};
+void writeLE16(uint8_t* p, uint16_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+}
 
-            uint32_t rSum = 0, gSum = 0, bSum = 0, aSum = 0;
-            for (const auto& c : colors) {
-                rSum += c.r;
-                gSum += c.g;
-                bSum += c.b;
-                aSum += c.a;
-            }
+void writeLE32(uint8_t* p, uint32_t value) {
+    p[0] = static_cast<uint8_t>(value);
+    p[1] = static_cast<uint8_t>(value >> 8);
+    p[2] = static_cast<uint8_t>(value >> 16);
+    p[3] = static_cast<uint8_t>(value >> 24);
+}
 
-            size_t count = colors.size();
-            return Color{
-                static_cast<uint8_t>(rSum / count),
-                static_cast<uint8_t>(gSum / count),
-                static_cast<uint8_t>(bSum / count),
-                static_cast<uint8_t>(aSum / count)
-            };
-        }
-    };
+IndexedImageHeader readIndexedImageHeader(const uint8_t* src) {
+    IndexedImageHeader header;
+    std::memcpy(header.magic, src, sizeof(header.magic));
+    header.version = readLE16(src + 4);
+    header.compression = readLE16(src + 6);
+    header.width = readLE32(src + 8);
+    header.height = readLE32(src + 12);
+    header.planeSize = readLE32(src + 16);
+    for (int i = 0; i < 3; ++i) {
+        header.reserved[i] = readLE32(src + 20 + i * 4);
+    }
+    return header;
+}
 
-    // Find nearest color in palette
-    uint8_t findNearestPaletteIndex(const Color& color, const std::array<Color, 256>& palette, int paletteSize) {
-        int bestIndex = 0;
-        int bestDistance = INT_MAX;
+void writeIndexedImageHeader(const IndexedImageHeader& header, uint8_t* dest) {
+    std::memcpy(dest, header.magic, sizeof(header.magic));
+    writeLE16(dest + 4, header.version);
+    writeLE16(dest + 6, header.compression);
+    writeLE32(dest + 8, header.width);
+    writeLE32(dest + 12, header.height);
+    writeLE32(dest + 16, header.planeSize);
+    for (int i = 0; i < 3; ++i) {
+        writeLE32(dest + 20 + i * 4, header.reserved[i]);
+    }
+}
 
-        for (int i = 0; i < paletteSize; ++i) {
-            int dr = static_cast<int>(color.r) - palette[i].r;
-            int dg = static_cast<int>(color.g) - palette[i].g;
-            int db = static_cast<int>(color.b) - palette[i].b;
-            int distance = dr*dr + dg*dg + db*db;
+bool isIndexedImagePath(const std::string& path) {
+    if (path.size() < 4) {
+        return false;
+    }
+    std::string extension = path.substr(path.size() - 4);
+    std::transform(extension.begin(), extension.end(), extension.begin(),
+                   [](unsigned char c) { return static_cast<char>(std::tolower(c)); });
+    return extension == ".idx";
+}
 
-            if (distance < bestDistance) {
-                bestDistance = distance;
-                bestIndex = i;
+// PackBits: runs of 2-129 equal bytes become (257 - length, value), everything
+// else goes out as literal blocks of up to 128 bytes behind (length - 1)
+void encodeRLERow(const uint8_t* row, int width, std::vector<uint8_t>& out) {
+    int x = 0;
+    while (x < width) {
+        int run = 1;
+        while (x + run < width && run < 129 && row[x + run] == row[x]) {
+            ++run;
+        }
+        if (run >= 2) {
+            out.push_back(static_cast<uint8_t>(257 - run));
+            out.push_back(row[x]);
+            x += run;
+            continue;
+        }
+
+        // Literals up to the next run of three (shorter runs are cheaper inline)
+        int start = x;
+        while (x < width && x - start < 128) {
+            if (x + 2 < width && row[x] == row[x + 1] && row[x] == row[x + 2]) {
+                break;
             }
+            ++x;
         }
+        out.push_back(static_cast<uint8_t>(x - start - 1));
+        out.insert(out.end(), row + start, row + x);
+    }
+}
+
+// Checks that one PackBits row expands to exactly width bytes without running
+// past srcEnd
+bool validateRLERow(const uint8_t* src, const uint8_t* srcEnd, int width) {
+    int x = 0;
+    while (x < width) {
+        if (src >= srcEnd) {
+            return false;
+        }
+        int control = *src++;
+        bool literal = control < 128;
+        int run = literal ? control + 1 : 257 - control;
+        if (run > width - x || (literal ? run : 1) > srcEnd - src) {
+            return false;
+        }
+        src += literal ? run : 1;
+        x += run;
+    }
+    return true;
+}
 
-        return static_cast<uint8_t>(bestIndex);
+// Decodes one PackBits row (already accepted by validateRLERow) and writes its
+// columns [x1, x2) to dest
+void decodeRLERow(const uint8_t* src, int x1, int x2, uint8_t* dest) {
+    int x = 0;
+    while (x < x2) {
+        int control = *src++;
+        bool literal = control < 128;
+        int run = literal ? control + 1 : 257 - control;
+
+        int begin = std::max(x, x1);
+        int end = std::min(x + run, x2);
+        if (begin < end) {
+            if (literal) {
+                std::memcpy(dest + (begin - x1), src + (begin - x), static_cast<size_t>(end - begin));
+            } else {
+                std::memset(dest + (begin - x1), *src, static_cast<size_t>(end - begin));
+            }
+        }
+        src += literal ? run : 1;
+        x += run;
     }
 }
 
+} // anonymous namespace
+
 bool IndexedPixelBuffer::loadFromFile(const std::string& imagePath, int destX, int destY, bool fitPalette) {
+    if (isIndexedImagePath(imagePath)) {
+        return loadFromIndexedFile(imagePath, destX, destY, fitPalette);
+    }
+
+    PROFILE_ZONE("IndexedPixelBuffer::loadFromFile");
+
     // Load image using SDL_image
     SDL_Surface* surface = IMG_Load(imagePath.c_str());
     if (!surface) {
@@ -259,112 +1125,197 @@ bool IndexedPixelBuffer::loadFromFile(const std::string& imagePath, int destX, i
     }
 
     SDL_LockSurface(convertedSurface);
-    Uint32* pixels = static_cast<Uint32*>(convertedSurface->pixels);
-
-    // Collect all unique colors
-    std::vector<Color> imageColors;
-    for (int y = 0; y < convertedSurface->h; ++y) {
-        for (int x = 0; x < convertedSurface->w; ++x) {
-            Uint32 pixel = pixels[y * convertedSurface->w + x];
-            Color color;
-            color.r = (pixel >> 24) & 0xFF;
-            color.g = (pixel >> 16) & 0xFF;
-            color.b = (pixel >> 8) & 0xFF;
-            color.a = pixel & 0xFF;
-            imageColors.push_back(color);
-        }
-    }
-
-    std::array<Color, 256> newPalette = palette_;  // Start with current palette
-
-    if (fitPalette && imageColors.size() > 1) {
-        // Median-cut quantization to generate 256-color palette
-        std::vector<ColorBox> boxes;
-        boxes.push_back(ColorBox{imageColors});
-
-        // Split boxes until we have 256
-        while (boxes.size() < 256) {
-            // Find box with largest range
-            size_t largestIdx = 0;
-            int largestRange = 0;
-
-            for (size_t i = 0; i < boxes.size(); ++i) {
-                int rRange, gRange, bRange;
-                boxes[i].computeRange(rRange, gRange, bRange);
-                int totalRange = rRange + gRange + bRange;
-
-                if (totalRange > largestRange) {
-                    largestRange = totalRange;
-                    largestIdx = i;
-                }
-            }
 
-            if (largestRange == 0) break;  // All boxes are single colors
+    // RGBA32 stores bytes R, G, B, A on every platform - the layout of Color
+    static_assert(sizeof(Color) == 4, "Color must match SDL_PIXELFORMAT_RGBA32");
+    const Color* pixels = static_cast<const Color*>(convertedSurface->pixels);
+    int imageWidth = convertedSurface->w;
+    int imageHeight = convertedSurface->h;
+    int imagePitch = convertedSurface->pitch / static_cast<int>(sizeof(Color));
+
+    if (fitPalette && imageWidth * imageHeight > 1) {
+        setPalette(Palette::createOptimized(pixels, imageWidth, imageHeight, imagePitch).getColors());
+    }
 
-            // Split the largest box
-            ColorBox& box = boxes[largestIdx];
-            int rRange, gRange, bRange;
-            box.computeRange(rRange, gRange, bRange);
+    copyFromRGBA(pixels, imageWidth, imageHeight, imagePitch, destX, destY);
 
-            // Split along longest axis
-            if (rRange >= gRange && rRange >= bRange) {
-                std::sort(box.colors.begin(), box.colors.end(),
-                         [](const Color& a, const Color& b) { return a.r < b.r; });
-            } else if (gRange >= bRange) {
-                std::sort(box.colors.begin(), box.colors.end(),
-                         [](const Color& a, const Color& b) { return a.g < b.g; });
-            } else {
-                std::sort(box.colors.begin(), box.colors.end(),
-                         [](const Color& a, const Color& b) { return a.b < b.b; });
-            }
+    SDL_UnlockSurface(convertedSurface);
+    SDL_FreeSurface(convertedSurface);
 
-            // Split in half
-            size_t mid = box.colors.size() / 2;
-            ColorBox newBox;
-            newBox.colors.assign(box.colors.begin() + mid, box.colors.end());
-            box.colors.erase(box.colors.begin() + mid, box.colors.end());
-            boxes.push_back(newBox);
-        }
+    return true;
+}
+
+void IndexedPixelBuffer::copyFromRGBA(const Color* pixels, int width, int height, int pitch,
+                                      int destX, int destY, bool exact) {
+    if (!pixels) {
+        return;
+    }
+    int x1 = std::max(0, -destX);
+    int y1 = std::max(0, -destY);
+    int x2 = std::min(width, width_ - destX);
+    int y2 = std::min(height, height_ - destY);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
 
-        // Generate palette from box averages
-        for (size_t i = 0; i < boxes.size() && i < 256; ++i) {
-            newPalette[i] = boxes[i].getAverageColor();
+    palette_.getInverseTable();  // Build it once, before the bands read it
+
+    uint8_t* destBase = pixels_.data();
+    int destPitch = width_;
+    size_t count = static_cast<size_t>(x2 - x1);
+    WorkerPool::getInstance().parallelForBands(y2 - y1, count * (sizeof(Color) + 1), [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+            int y = y1 + row;
+            palette_.mapColors(pixels + static_cast<ptrdiff_t>(y) * pitch + x1,
+                               destBase + static_cast<ptrdiff_t>(destY + y) * destPitch + destX + x1,
+                               count, exact);
         }
+    });
+    markPixelsDirty(destX + x1, destY + y1, x2 - x1, y2 - y1);
+}
+
+bool IndexedPixelBuffer::loadFromIndexedFile(const std::string& path, int destX, int destY, bool usePalette) {
+    PROFILE_ZONE("IndexedPixelBuffer::loadFromIndexedFile");
 
-        // Fill remaining palette entries with black
-        for (size_t i = boxes.size(); i < 256; ++i) {
-            newPalette[i] = Color{0, 0, 0, 255};
+    MappedFile file;
+    if (!file.open(path)) {
+        return false;
+    }
+
+    if (file.size() < kIndexedImageHeaderBytes + kIndexedImagePaletteBytes) {
+        std::cerr << "Not a baked indexed image: " << path << std::endl;
+        return false;
+    }
+    IndexedImageHeader header = readIndexedImageHeader(file.data());
+    if (std::memcmp(header.magic, kIndexedImageMagic, sizeof(header.magic)) != 0 ||
+        header.version != kIndexedImageVersion) {
+        std::cerr << "Not a baked indexed image (or unsupported version): " << path << std::endl;
+        return false;
+    }
+
+    int imageWidth = static_cast<int>(header.width);
+    int imageHeight = static_cast<int>(header.height);
+    const uint8_t* palette = file.data() + kIndexedImageHeaderBytes;
+    const uint8_t* plane = palette + kIndexedImagePaletteBytes;
+    size_t planeSize = header.planeSize;
+    size_t rawSize = static_cast<size_t>(header.width) * header.height;
+    size_t tableSize = static_cast<size_t>(header.height) * sizeof(uint32_t);
+    bool rle = header.compression == kIndexedImageRLE;
+    if (header.width == 0 || header.height == 0 ||
+        header.width > kIndexedImageMaxSide || header.height > kIndexedImageMaxSide ||
+        (header.compression != kIndexedImageRaw && !rle) ||
+        planeSize > file.size() - kIndexedImageHeaderBytes - kIndexedImagePaletteBytes ||
+        planeSize < (rle ? tableSize : rawSize)) {
+        std::cerr << "Corrupt baked indexed image: " << path << std::endl;
+        return false;
+    }
+
+    // Check every RLE row before touching the buffer, so a corrupt file leaves
+    // the palette and pixels unchanged
+    const uint8_t* rows = plane + tableSize;
+    const uint8_t* planeEnd = plane + planeSize;
+    if (rle) {
+        std::atomic<bool> corrupt{false};
+        WorkerPool::getInstance().parallelForBands(imageHeight, header.width, [&](int begin, int end) {
+            for (int y = begin; y < end && !corrupt.load(std::memory_order_relaxed); ++y) {
+                uint32_t offset = readLE32(plane + static_cast<size_t>(y) * sizeof(uint32_t));
+                if (offset > static_cast<size_t>(planeEnd - rows) ||
+                    !validateRLERow(rows + offset, planeEnd, imageWidth)) {
+                    corrupt.store(true, std::memory_order_relaxed);
+                }
+            }
+        });
+        if (corrupt.load(std::memory_order_relaxed)) {
+            std::cerr << "Corrupt baked indexed image: " << path << std::endl;
+            return false;
         }
+    }
 
-        setPalette(newPalette);
+    if (usePalette) {
+        std::array<Color, 256> colors;
+        std::memcpy(colors.data(), palette, kIndexedImagePaletteBytes);
+        setPalette(colors);
     }
 
-    // Map pixels to palette and copy to buffer
-    for (int y = 0; y < convertedSurface->h; ++y) {
-        for (int x = 0; x < convertedSurface->w; ++x) {
-            int bufX = destX + x;
-            int bufY = destY + y;
+    int x1 = std::max(0, -destX);
+    int y1 = std::max(0, -destY);
+    int x2 = std::min(imageWidth, width_ - destX);
+    int y2 = std::min(imageHeight, height_ - destY);
+    if (x1 >= x2 || y1 >= y2) {
+        return true;
+    }
 
-            if (bufX < 0 || bufX >= width_ || bufY < 0 || bufY >= height_) {
+    // Rows are independent (RLE rows through the offset table), so bands decode
+    // straight from the mapping into the buffer
+    uint8_t* destBase = pixels_.data();
+    WorkerPool::getInstance().parallelForBands(y2 - y1, static_cast<size_t>(x2 - x1) * 2, [&](int begin, int end) {
+        for (int row = begin; row < end; ++row) {
+            int y = y1 + row;
+            uint8_t* dest = destBase + static_cast<ptrdiff_t>(destY + y) * width_ + destX + x1;
+            if (!rle) {
+                std::memcpy(dest, plane + static_cast<size_t>(y) * header.width + x1, static_cast<size_t>(x2 - x1));
                 continue;
             }
+            uint32_t offset = readLE32(plane + static_cast<size_t>(y) * sizeof(uint32_t));
+            decodeRLERow(rows + offset, x1, x2, dest);
+        }
+    });
+    markPixelsDirty(destX + x1, destY + y1, x2 - x1, y2 - y1);
+    return true;
+}
 
-            Uint32 pixel = pixels[y * convertedSurface->w + x];
-            Color color;
-            color.r = (pixel >> 24) & 0xFF;
-            color.g = (pixel >> 16) & 0xFF;
-            color.b = (pixel >> 8) & 0xFF;
-            color.a = pixel & 0xFF;
-
-            uint8_t paletteIndex = findNearestPaletteIndex(color, newPalette, 256);
-            pixels_[bufY * width_ + bufX] = paletteIndex;
+bool IndexedPixelBuffer::saveToIndexedFile(const std::string& path, bool rle) const {
+    PROFILE_ZONE("IndexedPixelBuffer::saveToIndexedFile");
+
+    // The displayed pixels (the front buffer when double-buffered)
+    const uint8_t* pixels = getPixelData();
+    size_t rawSize = static_cast<size_t>(width_) * height_;
+
+    std::vector<uint8_t> plane;
+    uint16_t compression = kIndexedImageRaw;
+    if (rle) {
+        std::vector<uint32_t> offsets(static_cast<size_t>(height_));
+        std::vector<uint8_t> rows;
+        for (int y = 0; y < height_; ++y) {
+            offsets[y] = static_cast<uint32_t>(rows.size());
+            encodeRLERow(pixels + static_cast<size_t>(y) * width_, width_, rows);
+        }
+        size_t tableSize = offsets.size() * sizeof(uint32_t);
+        if (tableSize + rows.size() < rawSize) {
+            compression = kIndexedImageRLE;
+            plane.resize(tableSize + rows.size());
+            for (size_t y = 0; y < offsets.size(); ++y) {
+                writeLE32(plane.data() + y * sizeof(uint32_t), offsets[y]);
+            }
+            std::memcpy(plane.data() + tableSize, rows.data(), rows.size());
         }
     }
+    if (compression == kIndexedImageRaw) {
+        plane.assign(pixels, pixels + rawSize);
+    }
 
-    SDL_UnlockSurface(convertedSurface);
-    SDL_FreeSurface(convertedSurface);
-
-    markPixelsDirty();
+    IndexedImageHeader header{};
+    std::memcpy(header.magic, kIndexedImageMagic, sizeof(header.magic));
+    header.version = kIndexedImageVersion;
+    header.compression = compression;
+    header.width = static_cast<uint32_t>(width_);
+    header.height = static_cast<uint32_t>(height_);
+    header.planeSize = static_cast<uint32_t>(plane.size());
+
+    std::ofstream out(path, std::ios::binary);
+    if (!out) {
+        std::cerr << "Failed to open for writing: " << path << std::endl;
+        return false;
+    }
+    uint8_t headerBytes[kIndexedImageHeaderBytes];
+    writeIndexedImageHeader(header, headerBytes);
+    out.write(reinterpret_cast<const char*>(headerBytes), sizeof(headerBytes));
+    out.write(reinterpret_cast<const char*>(getPaletteData()), kIndexedImagePaletteBytes);
+    out.write(reinterpret_cast<const char*>(plane.data()), static_cast<std::streamsize>(plane.size()));
+    if (!out) {
+        std::cerr << "Failed to write baked indexed image: " << path << std::endl;
+        return false;
+    }
     return true;
 }
 
@@ -424,33 +1375,106 @@ void IndexedPixelBuffer::drawText(const PixelFontPtr& font, const std::string& t
         // Advance cursor
         cursorX += charWidth;
     }
-
-    markPixelsDirty();
 }
 
 void IndexedPixelBuffer::upload(IRenderer& renderer) {
+    PROFILE_ZONE("IndexedPixelBuffer::upload");
     if (!dirty_) {
         return;  // No changes, skip upload
     }
 
     // Create texture if it doesn't exist yet
+    // Palette and scanline table changes touch every pixel
+    bool fullUpload = paletteDirty_ || scanlineEffectsDirty_ || !pixelsDirty_;
     if (!texture_) {
         texture_ = renderer.createStreamingTexture(width_, height_);
         if (!texture_) {
             return;  // Failed to create texture
         }
+        fullUpload = true;
     }
 
-    // Convert indexed pixels to RGBA using the palette
-    std::vector<Color> rgbaPixels(width_ * height_);
-    for (int i = 0; i < width_ * height_; ++i) {
-        uint8_t index = pixels_[i];
-        rgbaPixels[i] = palette_[index];
+    // Convert only the dirty rectangle unless the whole texture is stale
+    int x = 0;
+    int y = 0;
+    int w = width_;
+    int h = height_;
+    if (!fullUpload) {
+        y = dirtyMinY_;
+        h = dirtyMaxY_ - dirtyMinY_ + 1;
+        if (scanlineEffects_.empty()) {  // Scrolled rows move pixels - keep whole rows
+            x = dirtyMinX_;
+            w = dirtyMaxX_ - dirtyMinX_ + 1;
+        }
     }
 
-    // Update texture with converted pixel data
-    renderer.updateTexture(*texture_, rgbaPixels.data(), width_, height_);
+    // Convert indexed pixels to RGBA using the palette (SIMD kernel, persistent staging)
+    const uint8_t* pixels = getPixelData();
+    staging_.resize(static_cast<size_t>(w) * h);
+    offsetPaletteKey_ = -1;  // Palettes may have changed since the last upload
+    if (!scanlineEffects_.empty()) {
+        for (int row = 0; row < h; ++row) {
+            expandScanline(y + row, &staging_[static_cast<size_t>(row) * w]);
+        }
+    } else if (w == width_) {
+        expandIndexed(pixels + static_cast<size_t>(y) * width_, getPaletteData(), staging_.data(), staging_.size());
+    } else {
+        for (int row = 0; row < h; ++row) {
+            expandIndexed(pixels + static_cast<size_t>(y + row) * width_ + x, getPaletteData(),
+                          &staging_[static_cast<size_t>(row) * w], static_cast<size_t>(w));
+        }
+    }
+
+    // Update texture with converted pixel data (backends without partial
+    // updates fall back to converting and uploading the full buffer)
+    if (w == width_ && h == height_) {
+        renderer.updateTexture(*texture_, staging_.data(), width_, height_);
+    } else if (!renderer.updateTextureRegion(*texture_, staging_.data(), x, y, w, h)) {
+        staging_.resize(static_cast<size_t>(width_) * height_);
+        if (!scanlineEffects_.empty()) {
+            for (int row = 0; row < height_; ++row) {
+                expandScanline(row, &staging_[static_cast<size_t>(row) * width_]);
+            }
+        } else {
+            expandIndexed(pixels, getPaletteData(), staging_.data(), staging_.size());
+        }
+        renderer.updateTexture(*texture_, staging_.data(), width_, height_);
+    }
+
+    // This path consumes pixel, palette and scanline table changes
     dirty_ = false;
+    pixelsDirty_ = false;
+    paletteDirty_ = false;
+    scanlineEffectsDirty_ = false;
+}
+
+void IndexedPixelBuffer::expandScanline(int y, Color* dest) {
+    const ScanlineEffect& effect = scanlineEffects_[y];
+    // Out-of-range banks show the main palette; resolve once so the rotation
+    // cache key names the palette actually used
+    int bank = effect.paletteBank < paletteBankCount_ ? effect.paletteBank : 0;
+    const Color* palette = getPaletteBankData(bank);
+
+    // An index offset is a rotated palette; consecutive lines usually share it
+    if (effect.paletteOffset != 0) {
+        int key = (bank << 8) | effect.paletteOffset;
+        if (key != offsetPaletteKey_) {
+            size_t offset = effect.paletteOffset;
+            std::copy(palette + offset, palette + 256, offsetPalette_.begin());
+            std::copy(palette, palette + offset, offsetPalette_.begin() + (256 - offset));
+            offsetPaletteKey_ = key;
+        }
+        palette = offsetPalette_.data();
+    }
+
+    // Displayed column x shows source column (x - scrollX) mod width
+    int shift = effect.scrollX % width_;
+    if (shift < 0) {
+        shift += width_;
+    }
+    const uint8_t* row = getPixelData() + static_cast<size_t>(y) * width_;
+    expandIndexed(row + (width_ - shift), palette, dest, static_cast<size_t>(shift));
+    expandIndexed(row, palette, dest + shift, static_cast<size_t>(width_ - shift));
 }
 
 void IndexedPixelBuffer::render(IRenderer& renderer, const Vec2& layerOffset, float opacity) {
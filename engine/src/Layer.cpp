@@ -1,5 +1,6 @@
 #include "engine/Layer.h"
 #include "engine/IRenderer.h"
+#include "engine/Profiler.h"
 #include <algorithm>
 
 namespace Engine {
@@ -130,6 +131,7 @@ void Layer::clearAttachables() {
 }
 
 void Layer::render(IRenderer& renderer) {
+    PROFILE_ZONE("Layer::render");
     if (!visible_) return;
 
     // Render tilemaps first (usually background)
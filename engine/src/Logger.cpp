@@ -0,0 +1,302 @@
+#include "engine/Logger.h"
+#include <algorithm>
+#include <cstring>
+#include <ctime>
+
+namespace Engine {
+
+Logger::Logger()
+    : output_(std::make_unique<ConsoleOutput>())
+    , minLevel_(LogLevel::Info)
+    , showTimestamp_(true)
+    , showWallClock_(true)
+    , showFrame_(true)
+    , showLevel_(true)
+    , frameNumber_(0)
+    , startTime_(std::chrono::steady_clock::now()) {
+    formatted_.reserve(256);
+}
+
+Logger::~Logger() {
+    stopAsync();
+}
+
+void Logger::setOutput(std::unique_ptr<LogOutput> output) {
+    // The consumer may be mid-batch; finish it on the old output first
+    flush();
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    output_ = std::move(output);
+}
+
+const char* Logger::levelToString(LogLevel level) {
+    switch (level) {
+        case LogLevel::Debug:   return "DEBUG";
+        case LogLevel::Info:    return "INFO ";
+        case LogLevel::Warning: return "WARN ";
+        case LogLevel::Error:   return "ERROR";
+    }
+    return "UNKNOWN";
+}
+
+void Logger::capture(Record& record, LogLevel level, size_t length, const char* file, int line) const {
+    record.level = level;
+    record.file = file;
+    record.line = line;
+    record.frame = frameNumber_.load(std::memory_order_relaxed);
+    record.steadyMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::steady_clock::now() - startTime_).count();
+    record.wallMs = std::chrono::duration_cast<std::chrono::milliseconds>(
+        std::chrono::system_clock::now().time_since_epoch()).count();
+    record.length = static_cast<uint32_t>(std::min(length, kMaxAsyncMessageLength));
+}
+
+void Logger::log(LogLevel level, const char* message, size_t length,
+                 const char* file, int line) {
+    if (level < minLevel_.load(std::memory_order_relaxed)) return;
+
+    // Announce the producer before checking the mode: stopAsync() clears async_
+    // and then waits for this count to reach zero, so a record is either pushed
+    // before the consumer's final drain or takes the synchronous path
+    activeProducers_.fetch_add(1, std::memory_order_seq_cst);
+    if (async_.load(std::memory_order_seq_cst)) {
+        if (!tryPush(level, message, length, file, line)) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+        }
+        activeProducers_.fetch_sub(1, std::memory_order_release);
+        return;
+    }
+    activeProducers_.fetch_sub(1, std::memory_order_release);
+
+    // Synchronous: format, write and flush on the calling thread
+    Record record;
+    capture(record, level, length, file, line);
+
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    if (!output_) return;
+    formatRecord(record, message, length);
+    output_->write(formatted_);
+    output_->flush();
+}
+
+void Logger::formatRecord(const Record& record, const char* message, size_t length) {
+    char prefix[128];
+    int used = 0;
+    auto append = [&](const char* fmt, auto... args) {
+        int n = std::snprintf(prefix + used, sizeof(prefix) - used, fmt, args...);
+        if (n > 0) used = std::min(used + n, static_cast<int>(sizeof(prefix)) - 1);
+    };
+
+    // Timestamp (time since logger creation)
+    if (showTimestamp_) {
+        append("[%8lldms] ", static_cast<long long>(record.steadyMs));
+    }
+
+    // Wall clock time
+    if (showWallClock_) {
+        int64_t second = record.wallMs / 1000;
+        if (second != cachedWallSecond_) {
+            std::time_t time = static_cast<std::time_t>(second);
+            std::tm tm;
+            #ifdef _WIN32
+                localtime_s(&tm, &time);
+            #else
+                localtime_r(&time, &tm);
+            #endif
+            std::strftime(cachedWallClock_, sizeof(cachedWallClock_), "%H:%M:%S", &tm);
+            cachedWallSecond_ = second;
+        }
+        append("[%s.%03d] ", cachedWallClock_, static_cast<int>(record.wallMs % 1000));
+    }
+
+    // Frame number
+    if (showFrame_) {
+        append("[F:%6llu] ", static_cast<unsigned long long>(record.frame));
+    }
+
+    // Log level
+    if (showLevel_) {
+        append("[%s] ", levelToString(record.level));
+    }
+
+    formatted_.assign(prefix, static_cast<size_t>(used));
+
+    // File and line (if provided)
+    if (record.file && record.line >= 0) {
+        // Extract just filename from path
+        const char* filename = record.file;
+        for (const char* p = record.file; *p; ++p) {
+            if (*p == '/' || *p == '\\') {
+                filename = p + 1;
+            }
+        }
+        formatted_ += '[';
+        formatted_ += filename;
+        formatted_ += ':';
+        formatted_ += std::to_string(record.line);
+        formatted_ += "] ";
+    }
+
+    // Message
+    formatted_.append(message, length);
+}
+
+// ---------------------------------------------------------------------------
+// Asynchronous mode
+// ---------------------------------------------------------------------------
+
+bool Logger::tryPush(LogLevel level, const char* message, size_t length, const char* file, int line) {
+    // Bounded MPSC queue (Vyukov): a slot is free for position pos when its
+    // sequence equals pos, and published when it equals pos + 1
+    uint64_t pos = enqueuePos_.load(std::memory_order_relaxed);
+    Record* slot;
+    for (;;) {
+        slot = &ring_[pos & ringMask_];
+        uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+        int64_t diff = static_cast<int64_t>(sequence) - static_cast<int64_t>(pos);
+        if (diff == 0) {
+            if (enqueuePos_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                break;
+            }
+        } else if (diff < 0) {
+            return false;  // Full
+        } else {
+            pos = enqueuePos_.load(std::memory_order_relaxed);
+        }
+    }
+
+    capture(*slot, level, length, file, line);
+    std::memcpy(slot->message, message, slot->length);
+    slot->sequence.store(pos + 1, std::memory_order_release);
+
+    // The consumer polls on a short timeout; only wake it early when the ring
+    // is filling up or an error should reach the output promptly
+    uint64_t pending = pos + 1 - processed_.load(std::memory_order_relaxed);
+    if (level == LogLevel::Error || pending > (ringMask_ + 1) / 2) {
+        wakeCondition_.notify_one();
+    }
+    return true;
+}
+
+size_t Logger::drain() {
+    size_t count = 0;
+    std::lock_guard<std::mutex> lock(outputMutex_);
+
+    for (;;) {
+        Record& slot = ring_[dequeuePos_ & ringMask_];
+        if (slot.sequence.load(std::memory_order_acquire) != dequeuePos_ + 1) {
+            break;  // Empty, or the next producer has not published yet
+        }
+
+        if (output_) {
+            formatRecord(slot, slot.message, slot.length);
+            output_->write(formatted_);
+        }
+
+        // Hand the slot back to producers one lap later
+        slot.sequence.store(dequeuePos_ + ringMask_ + 1, std::memory_order_release);
+        ++dequeuePos_;
+        ++count;
+    }
+
+    if (count > 0) {
+        if (output_) {
+            output_->flush();
+        }
+        processed_.store(dequeuePos_, std::memory_order_release);
+    }
+    return count;
+}
+
+void Logger::consumerLoop() {
+    uint64_t reportedDrops = 0;
+
+    while (!stopRequested_.load(std::memory_order_acquire)) {
+        if (drain() == 0) {
+            std::unique_lock<std::mutex> lock(wakeMutex_);
+            wakeCondition_.wait_for(lock, std::chrono::milliseconds(5));
+        }
+
+        uint64_t drops = dropped_.load(std::memory_order_relaxed);
+        if (drops != reportedDrops) {
+            std::lock_guard<std::mutex> lock(outputMutex_);
+            if (output_) {
+                output_->write("[Logger] " + std::to_string(drops - reportedDrops) +
+                               " messages dropped (async ring buffer full)");
+                output_->flush();
+            }
+            reportedDrops = drops;
+        }
+    }
+
+    // Final drain after producers were switched back to synchronous mode
+    drain();
+}
+
+void Logger::setAsync(bool async, size_t capacity) {
+    if (async == isAsync()) {
+        return;
+    }
+
+    if (!async) {
+        stopAsync();
+        return;
+    }
+
+    // Round capacity up to a power of two
+    size_t slots = 2;
+    while (slots < capacity) {
+        slots <<= 1;
+    }
+
+    // No producer holds the ring here (stopAsync waited for them), but keep
+    // the allocation when the capacity is unchanged
+    if (ring_.size() != slots) {
+        ring_ = std::vector<Record>(slots);
+    }
+    for (size_t i = 0; i < slots; ++i) {
+        ring_[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    ringMask_ = slots - 1;
+    enqueuePos_.store(0, std::memory_order_relaxed);
+    dequeuePos_ = 0;
+    processed_.store(0, std::memory_order_relaxed);
+    stopRequested_.store(false, std::memory_order_relaxed);
+
+    consumer_ = std::thread(&Logger::consumerLoop, this);
+    async_.store(true, std::memory_order_release);
+}
+
+void Logger::stopAsync() {
+    if (!consumer_.joinable()) {
+        return;
+    }
+
+    // New records go the synchronous path. Producers that already saw async
+    // mode finish publishing first, so the consumer's final drain sees them all
+    async_.store(false, std::memory_order_seq_cst);
+    while (activeProducers_.load(std::memory_order_seq_cst) != 0) {
+        std::this_thread::yield();
+    }
+    stopRequested_.store(true, std::memory_order_release);
+    wakeCondition_.notify_one();
+    consumer_.join();
+}
+
+void Logger::flush() {
+    if (isAsync()) {
+        // Wait until everything claimed so far has been written
+        uint64_t target = enqueuePos_.load(std::memory_order_acquire);
+        while (processed_.load(std::memory_order_acquire) < target && isAsync()) {
+            wakeCondition_.notify_one();
+            std::this_thread::yield();
+        }
+        return;
+    }
+
+    std::lock_guard<std::mutex> lock(outputMutex_);
+    if (output_) {
+        output_->flush();
+    }
+}
+
+} // namespace Engine
@@ -1,7 +1,9 @@
 #define _USE_MATH_DEFINES  // Must be before <cmath> for M_PI on Windows
 #include "engine/Mesh3D.h"
 #include "engine/IndexedPixelBuffer.h"
+#include "engine/ShadeTable.h"
 #include "engine/Sprite.h"
+#include <algorithm>
 #include <cmath>
 
 namespace Engine {
@@ -192,8 +194,9 @@ void Mesh3D::renderToBuffer(IndexedPixelBuffer& buffer) const {
         }
     }
 
-    // Transform vertices
-    std::vector<Vec3> transformed(vertices_.size());
+    // Transform vertices (scratch buffers are reused across frames)
+    std::vector<Vec3>& transformed = transformedScratch_;
+    transformed.resize(vertices_.size());
 
     // Precompute rotation matrix components
     float cosX = std::cos(rotation_.x);
@@ -223,7 +226,8 @@ void Mesh3D::renderToBuffer(IndexedPixelBuffer& buffer) const {
 
     // Transform normals (if we have them)
     // Normals are rotated but not scaled or translated
-    std::vector<Vec3> transformedNormals(normals_.size());
+    std::vector<Vec3>& transformedNormals = normalScratch_;
+    transformedNormals.resize(normals_.size());
     for (size_t i = 0; i < normals_.size(); ++i) {
         Vec3 n = normals_[i];
 
@@ -243,6 +247,23 @@ void Mesh3D::renderToBuffer(IndexedPixelBuffer& buffer) const {
         transformedNormals[i].normalize();
     }
 
+    // Project every vertex once (shared by all faces that use it)
+    std::vector<Vec2>& projected = projectedScratch_;
+    projected.resize(transformed.size());
+    for (size_t i = 0; i < transformed.size(); ++i) {
+        const Vec3& p = transformed[i];
+        float z = p.z + cameraDistance_;
+        if (z < 1.0f) z = 1.0f;  // Avoid division by zero
+
+        // Keep sub-pixel precision for the rasterizer
+        projected[i] = Vec2{finalPosition.x + (p.x * focalLength_) / z,
+                            finalPosition.y + (p.y * focalLength_) / z};
+    }
+
+    std::vector<WireEdge>& edges = edgeScratch_;
+    edges.clear();
+    std::vector<Vec2>& outline = outlineScratch_;  // One face's projected vertices
+
     // View direction (camera looking down -Z axis)
     Vec3 viewDir(0, 0, -1);
 
@@ -277,12 +298,15 @@ void Mesh3D::renderToBuffer(IndexedPixelBuffer& buffer) const {
         // Use the polygon's base color and modulate brightness based on lighting
         lightIntensity = std::max(0.0f, std::min(1.0f, lightIntensity));
 
-        // Map light intensity to brightness level
-        // Palette layout: 1-7 (bright), 8-14 (medium), 15-21 (dark)
+        // Map light intensity to a shade of the face color: through the shade
+        // table if set, else palette layout 1-7 (bright), 8-14 (medium), 15-21 (dark)
         uint8_t baseColor = poly.color;
         uint8_t litColor;
 
-        if (lightIntensity > 0.67f) {
+        if (shadeTable_) {
+            int top = shadeTable_->getLevelCount() - 1;
+            litColor = shadeTable_->shade(baseColor, static_cast<int>(lightIntensity * top + 0.5f));
+        } else if (lightIntensity > 0.67f) {
             // High intensity: use bright color (original palette index 1-7)
             litColor = baseColor;
         } else if (lightIntensity > 0.33f) {
@@ -293,46 +317,65 @@ void Mesh3D::renderToBuffer(IndexedPixelBuffer& buffer) const {
             litColor = baseColor + 14;
         }
 
-        // Project all vertices for this polygon
-        std::vector<Vec2> projected;
-        projected.reserve(poly.vertices.size());
-
-        for (int vIdx : poly.vertices) {
-            Vec3 p = transformed[vIdx];
-            float z = p.z + cameraDistance_;
-            if (z < 1.0f) z = 1.0f;  // Avoid division by zero
-
-            int x = static_cast<int>(finalPosition.x + (p.x * focalLength_) / z);
-            int y = static_cast<int>(finalPosition.y + (p.y * focalLength_) / z);
-            projected.push_back(Vec2{static_cast<float>(x), static_cast<float>(y)});
-        }
-
         // Render based on mode
         if (renderMode_ == MeshRenderMode::Filled) {
-            // Triangulate and fill the polygon
-            // For triangles: draw directly
-            // For quads+: fan triangulation from first vertex
-            for (size_t i = 1; i + 1 < projected.size(); ++i) {
-                buffer.fillTriangle(
-                    static_cast<int>(projected[0].x), static_cast<int>(projected[0].y),
-                    static_cast<int>(projected[i].x), static_cast<int>(projected[i].y),
-                    static_cast<int>(projected[i + 1].x), static_cast<int>(projected[i + 1].y),
-                    litColor
-                );
+            // Fill the whole face in one scanline pass (no per-triangle setup
+            // or shared diagonals for quads and larger faces)
+            outline.clear();
+            for (int vertex : poly.vertices) {
+                outline.push_back(projected[vertex]);
             }
+            buffer.fillPolygon(outline.data(), outline.size(), litColor);
         } else {
-            // Wireframe mode: draw edges only
-            // Draw lines connecting all vertices in order, plus closing edge
-            for (size_t i = 0; i < projected.size(); ++i) {
-                size_t next = (i + 1) % projected.size();
-                buffer.drawLine(
-                    static_cast<int>(projected[i].x), static_cast<int>(projected[i].y),
-                    static_cast<int>(projected[next].x), static_cast<int>(projected[next].y),
-                    litColor
-                );
+            // Wireframe mode: collect edges (including the closing edge);
+            // edges shared by visible faces are drawn once below
+            for (size_t i = 0; i < poly.vertices.size(); ++i) {
+                uint32_t a = static_cast<uint32_t>(poly.vertices[i]);
+                uint32_t b = static_cast<uint32_t>(poly.vertices[(i + 1) % poly.vertices.size()]);
+                uint64_t key = (static_cast<uint64_t>(std::min(a, b)) << 32) | std::max(a, b);
+                edges.push_back({key, litColor, false});
             }
         }
     }
+
+    if (edges.empty()) {
+        return;
+    }
+
+    // Keep the last occurrence of each edge (the color the face drawn last
+    // would have left), then draw in face order, batching runs of one color
+    std::vector<uint32_t>& order = edgeOrderScratch_;
+    order.resize(edges.size());
+    for (size_t i = 0; i < order.size(); ++i) {
+        order[i] = static_cast<uint32_t>(i);
+    }
+    std::sort(order.begin(), order.end(), [&edges](uint32_t a, uint32_t b) {
+        return edges[a].key != edges[b].key ? edges[a].key < edges[b].key : a < b;
+    });
+    for (size_t i = 0; i + 1 < order.size(); ++i) {
+        if (edges[order[i]].key == edges[order[i + 1]].key) {
+            edges[order[i]].duplicate = true;
+        }
+    }
+
+    std::vector<Vec2>& segments = segmentScratch_;
+    segments.clear();
+    uint8_t runColor = 0;
+    for (const WireEdge& edge : edges) {
+        if (edge.duplicate) {
+            continue;
+        }
+        if (!segments.empty() && edge.color != runColor) {
+            buffer.drawLines(segments.data(), segments.size(), runColor);
+            segments.clear();
+        }
+        runColor = edge.color;
+        segments.push_back(projected[edge.key >> 32]);
+        segments.push_back(projected[edge.key & 0xFFFFFFFFu]);
+    }
+    if (!segments.empty()) {
+        buffer.drawLines(segments.data(), segments.size(), runColor);
+    }
 }
 
 std::shared_ptr<Mesh3D> Mesh3D::createCube(float size) {
@@ -1,14 +1,76 @@
 #include "engine/Palette.h"
+#include "engine/Profiler.h"
+#include "engine/WorkerPool.h"
 #include <SDL_image.h>
 #include <fstream>
 #include <sstream>
 #include <iostream>
 #include <cmath>
 #include <algorithm>  // For std::clamp (C++17)
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 namespace Engine {
 
+namespace {
+
+// Blend tables shared between palettes with equal colors. Entries hold tables
+// weakly - a table lives while some palette's blendTables_ still caches it.
+struct SharedBlendTable {
+    uint64_t colorsHash;
+    std::array<Color, 256> colors;
+    BlendMode mode;
+    uint8_t alpha;
+    std::weak_ptr<const BlendTable> table;
+};
+
+// Guards sharedBlendTables and every palette's blendTables_. One lock for all
+// palettes: lookups happen per draw call, not per pixel.
+std::mutex blendCacheMutex;
+std::vector<SharedBlendTable> sharedBlendTables;
+
+uint64_t hashColors(const std::array<Color, 256>& colors) {
+    uint64_t hash = 14695981039346656037ull;  // FNV-1a
+    const uint8_t* bytes = reinterpret_cast<const uint8_t*>(colors.data());
+    for (size_t i = 0; i < sizeof(Color) * colors.size(); ++i) {
+        hash = (hash ^ bytes[i]) * 1099511628211ull;
+    }
+    return hash;
+}
+
+bool sameColors(const std::array<Color, 256>& a, const std::array<Color, 256>& b) {
+    return std::memcmp(a.data(), b.data(), sizeof(Color) * a.size()) == 0;
+}
+
+} // anonymous namespace
+
+void Palette::setColors(const std::array<Color, 256>& colors) {
+    if (sameColors(colors, colors_)) {
+        return;
+    }
+    colors_ = colors;
+    invalidateCaches();
+}
+
+void Palette::setColor(uint8_t index, const Color& color) {
+    const Color& current = colors_[index];
+    if (current.r == color.r && current.g == color.g && current.b == color.b && current.a == color.a) {
+        return;
+    }
+    colors_[index] = color;
+    invalidateCaches();
+}
+
+void Palette::invalidateCaches() {
+    std::atomic_store(&inverse_, std::shared_ptr<const InverseTable>());
+    std::lock_guard<std::mutex> lock(blendCacheMutex);
+    blendTables_.clear();
+}
+
 bool Palette::loadFromFile(const std::string& path) {
+    invalidateCaches();
     std::ifstream file(path);
     if (!file.is_open()) {
         std::cerr << "Failed to open palette file: " << path << std::endl;
@@ -65,6 +127,7 @@ bool Palette::loadFromFile(const std::string& path) {
 }
 
 bool Palette::loadFromImage(const std::string& imagePath) {
+    invalidateCaches();
     // Load image using SDL_image
     SDL_Surface* surface = IMG_Load(imagePath.c_str());
     if (!surface) {
@@ -82,17 +145,19 @@ bool Palette::loadFromImage(const std::string& imagePath) {
     }
 
     SDL_LockSurface(convertedSurface);
-    Uint32* pixels = static_cast<Uint32*>(convertedSurface->pixels);
+    const uint8_t* pixels = static_cast<const uint8_t*>(convertedSurface->pixels);
 
-    // Read up to 256 pixels from the image (row by row, left to right)
+    // Read up to 256 pixels from the image (row by row, left to right).
+    // RGBA32 stores bytes R, G, B, A in memory on every platform.
     int pixelCount = std::min(256, convertedSurface->w * convertedSurface->h);
 
     for (int i = 0; i < pixelCount; ++i) {
-        Uint32 pixel = pixels[i];
-        colors_[i].r = (pixel >> 24) & 0xFF;
-        colors_[i].g = (pixel >> 16) & 0xFF;
-        colors_[i].b = (pixel >> 8) & 0xFF;
-        colors_[i].a = pixel & 0xFF;
+        const uint8_t* pixel = pixels + static_cast<ptrdiff_t>(i / convertedSurface->w) * convertedSurface->pitch +
+                               (i % convertedSurface->w) * 4;
+        colors_[i].r = pixel[0];
+        colors_[i].g = pixel[1];
+        colors_[i].b = pixel[2];
+        colors_[i].a = pixel[3];
     }
 
     // Fill remaining entries with black
@@ -253,4 +318,340 @@ Palette Palette::createRainbow() {
     return palette;
 }
 
+namespace {
+
+inline int colorDistance(const Color& a, int r, int g, int b) {
+    int dr = static_cast<int>(a.r) - r;
+    int dg = static_cast<int>(a.g) - g;
+    int db = static_cast<int>(a.b) - b;
+    return dr * dr + dg * dg + db * db;
+}
+
+// Squared distance from v to the nearest and farthest points of [lo, hi]
+inline int axisMin(int v, int lo, int hi) {
+    int d = v < lo ? lo - v : (v > hi ? v - hi : 0);
+    return d * d;
+}
+inline int axisMax(int v, int lo, int hi) {
+    int d = std::max(std::abs(v - lo), std::abs(v - hi));
+    return d * d;
+}
+
+} // anonymous namespace
+
+uint8_t Palette::InverseTable::findNearest(const Color& color, const Color* palette) const {
+    constexpr int shift = 8 - kCellBits;
+    int cell = ((color.r >> shift) << (2 * kCellBits)) | ((color.g >> shift) << kCellBits) | (color.b >> shift);
+    const uint8_t* candidate = candidates.data() + cellStart[cell];
+    const uint8_t* end = candidates.data() + cellStart[cell + 1];
+
+    uint8_t bestIndex = *candidate;
+    int bestDistance = colorDistance(palette[bestIndex], color.r, color.g, color.b);
+    for (++candidate; candidate < end; ++candidate) {
+        int distance = colorDistance(palette[*candidate], color.r, color.g, color.b);
+        if (distance < bestDistance) {
+            bestDistance = distance;
+            bestIndex = *candidate;
+        }
+    }
+    return bestIndex;
+}
+
+std::shared_ptr<const Palette::InverseTable> Palette::getInverseTable() const {
+    std::shared_ptr<const InverseTable> table = std::atomic_load(&inverse_);
+    if (table) {
+        return table;
+    }
+
+    PROFILE_ZONE("Palette::buildInverseTable");
+    auto built = std::make_shared<InverseTable>();
+    constexpr int cellSize = 1 << (8 - InverseTable::kCellBits);
+    constexpr int cellsPerAxis = 1 << InverseTable::kCellBits;
+
+    // Candidates of a cell: entries whose closest point in the cell is no farther
+    // than the best entry's farthest point - every nearest entry of every color in
+    // the cell passes, so scanning them in index order matches a full scan
+    int minDistance[256];
+    built->candidates.reserve(static_cast<size_t>(cellsPerAxis) * cellsPerAxis * cellsPerAxis * 8);
+    int cell = 0;
+    for (int cr = 0; cr < cellsPerAxis; ++cr) {
+        for (int cg = 0; cg < cellsPerAxis; ++cg) {
+            for (int cb = 0; cb < cellsPerAxis; ++cb, ++cell) {
+                int lo[3] = {cr * cellSize, cg * cellSize, cb * cellSize};
+                int bound = INT32_MAX;
+                for (int i = 0; i < 256; ++i) {
+                    const Color& c = colors_[i];
+                    minDistance[i] = axisMin(c.r, lo[0], lo[0] + cellSize - 1) +
+                                     axisMin(c.g, lo[1], lo[1] + cellSize - 1) +
+                                     axisMin(c.b, lo[2], lo[2] + cellSize - 1);
+                    int maxDistance = axisMax(c.r, lo[0], lo[0] + cellSize - 1) +
+                                      axisMax(c.g, lo[1], lo[1] + cellSize - 1) +
+                                      axisMax(c.b, lo[2], lo[2] + cellSize - 1);
+                    bound = std::min(bound, maxDistance);
+                }
+
+                built->cellStart[cell] = static_cast<uint32_t>(built->candidates.size());
+                for (int i = 0; i < 256; ++i) {
+                    if (minDistance[i] <= bound) {
+                        built->candidates.push_back(static_cast<uint8_t>(i));
+                    }
+                }
+            }
+        }
+    }
+    built->cellStart[cell] = static_cast<uint32_t>(built->candidates.size());
+
+    // RGB555 table from the exact lookup at each 8x8x8 cell's center
+    for (int bucket = 0; bucket < (1 << 15); ++bucket) {
+        Color center{static_cast<uint8_t>(((bucket >> 10) << 3) | 4),
+                     static_cast<uint8_t>((((bucket >> 5) & 31) << 3) | 4),
+                     static_cast<uint8_t>(((bucket & 31) << 3) | 4)};
+        built->nearest555[bucket] = built->findNearest(center, colors_.data());
+    }
+
+    table = built;
+    std::atomic_store(&inverse_, table);
+    return table;
+}
+
+uint8_t Palette::findNearest(const Color& color) const {
+    return getInverseTable()->findNearest(color, colors_.data());
+}
+
+uint8_t Palette::findNearestFast(const Color& color) const {
+    return getInverseTable()->findNearestFast(color);
+}
+
+std::shared_ptr<const BlendTable> Palette::getBlendTable(BlendMode mode, uint8_t alpha) const {
+    std::lock_guard<std::mutex> lock(blendCacheMutex);
+    for (const auto& table : blendTables_) {
+        if (table->getMode() == mode && table->getAlpha() == alpha) {
+            return table;
+        }
+    }
+
+    // Another palette with these colors may have built it already
+    uint64_t hash = hashColors(colors_);
+    std::shared_ptr<const BlendTable> table;
+    for (const SharedBlendTable& shared : sharedBlendTables) {
+        if (shared.colorsHash == hash && shared.mode == mode && shared.alpha == alpha &&
+            sameColors(shared.colors, colors_)) {
+            table = shared.table.lock();
+            if (table) {
+                break;
+            }
+        }
+    }
+    if (!table) {
+        table = BlendTable::create(*this, mode, alpha);
+        sharedBlendTables.erase(std::remove_if(sharedBlendTables.begin(), sharedBlendTables.end(),
+                                               [](const SharedBlendTable& shared) { return shared.table.expired(); }),
+                                sharedBlendTables.end());
+        sharedBlendTables.push_back({hash, colors_, mode, alpha, table});
+    }
+    blendTables_.push_back(table);
+    return table;
+}
+
+void Palette::mapColors(const Color* src, uint8_t* dest, size_t count, bool exact) const {
+    if (count == 0) {
+        return;
+    }
+    std::shared_ptr<const InverseTable> table = getInverseTable();
+    if (!exact) {
+        for (size_t i = 0; i < count; ++i) {
+            dest[i] = table->findNearestFast(src[i]);
+        }
+        return;
+    }
+
+    // Runs of one color (flat areas) share a search
+    Color last = src[0];
+    uint8_t lastIndex = table->findNearest(last, colors_.data());
+    for (size_t i = 0; i < count; ++i) {
+        const Color& color = src[i];
+        if (color.r != last.r || color.g != last.g || color.b != last.b) {
+            last = color;
+            lastIndex = table->findNearest(color, colors_.data());
+        }
+        dest[i] = lastIndex;
+    }
+}
+
+namespace {
+
+// 5-5-5 RGB histogram used by createOptimized()
+constexpr int kHistogramSize = 1 << 15;
+
+inline int histogramBucket(const Color& c) {
+    return ((c.r >> 3) << 10) | ((c.g >> 3) << 5) | (c.b >> 3);
+}
+
+// Per-task partial histogram bin; 32-bit sums hold kMaxPixelsPerTask pixels of 255
+struct PartialBin {
+    uint32_t count, r, g, b, a;
+};
+constexpr int64_t kMaxPixelsPerTask = (int64_t(1) << 32) / 256;
+
+// An occupied bucket: pixel count, channel sums and mean color
+struct HistogramEntry {
+    uint64_t count;
+    uint64_t sum[4];  // r, g, b, a
+    int mean[3];      // Median split keys
+};
+
+// A median-cut box: a run of entries plus its pixel statistics
+struct QuantizeBox {
+    size_t begin, end;
+    uint64_t count;
+    uint64_t sum[4];
+    double error;  // Sum of squared distances of the pixels (entry means) from the box mean
+    int axis;      // Channel with the largest spread
+};
+
+QuantizeBox makeBox(const std::vector<HistogramEntry>& entries, size_t begin, size_t end) {
+    QuantizeBox box{begin, end, 0, {0, 0, 0, 0}, 0.0, 0};
+    double sumSq[3] = {0.0, 0.0, 0.0};
+    for (size_t i = begin; i < end; ++i) {
+        const HistogramEntry& e = entries[i];
+        box.count += e.count;
+        for (int c = 0; c < 4; ++c) {
+            box.sum[c] += e.sum[c];
+        }
+        for (int c = 0; c < 3; ++c) {
+            sumSq[c] += static_cast<double>(e.sum[c]) * e.sum[c] / e.count;  // count * mean^2
+        }
+    }
+
+    double bestVariance = -1.0;
+    for (int c = 0; c < 3; ++c) {
+        double mean = static_cast<double>(box.sum[c]) / box.count;
+        double variance = sumSq[c] - mean * static_cast<double>(box.sum[c]);
+        box.error += variance;
+        if (variance > bestVariance) {
+            bestVariance = variance;
+            box.axis = c;
+        }
+    }
+    return box;
+}
+
+} // anonymous namespace
+
+Palette Palette::createOptimized(const Color* pixels, int width, int height, int pitch, int colorCount) {
+    PROFILE_ZONE("Palette::createOptimized");
+    Palette palette;
+    palette.colors_.fill(Color{0, 0, 0, 255});
+    colorCount = std::clamp(colorCount, 1, 256);
+    if (!pixels || width <= 0 || height <= 0) {
+        return palette;
+    }
+
+    // Histogram: each task counts a row band into its own partial histogram
+    auto& pool = WorkerPool::getInstance();
+    int64_t pixelCount = static_cast<int64_t>(width) * height;
+    int64_t minTasks = (pixelCount + kMaxPixelsPerTask - 1) / kMaxPixelsPerTask;
+    int taskCount = pixelCount < 65536 ? 1 : pool.getThreadCount();
+    taskCount = static_cast<int>(std::min<int64_t>(height, std::max<int64_t>(taskCount, minTasks)));
+    std::vector<PartialBin> partials(static_cast<size_t>(taskCount) * kHistogramSize, PartialBin{0, 0, 0, 0, 0});
+
+    pool.parallelFor(taskCount, [&](int task) {
+        PartialBin* bins = partials.data() + static_cast<size_t>(task) * kHistogramSize;
+        int yBegin = static_cast<int>(static_cast<int64_t>(height) * task / taskCount);
+        int yEnd = static_cast<int>(static_cast<int64_t>(height) * (task + 1) / taskCount);
+        for (int y = yBegin; y < yEnd; ++y) {
+            const Color* row = pixels + static_cast<ptrdiff_t>(y) * pitch;
+            for (int x = 0; x < width; ++x) {
+                const Color& c = row[x];
+                PartialBin& bin = bins[histogramBucket(c)];
+                bin.count++;
+                bin.r += c.r;
+                bin.g += c.g;
+                bin.b += c.b;
+                bin.a += c.a;
+            }
+        }
+    });
+
+    // Merge into the list of occupied buckets (unique colors at 5-5-5 precision)
+    std::vector<HistogramEntry> entries;
+    for (int bucket = 0; bucket < kHistogramSize; ++bucket) {
+        HistogramEntry entry{0, {0, 0, 0, 0}, {0, 0, 0}};
+        for (int task = 0; task < taskCount; ++task) {
+            const PartialBin& bin = partials[static_cast<size_t>(task) * kHistogramSize + bucket];
+            entry.count += bin.count;
+            entry.sum[0] += bin.r;
+            entry.sum[1] += bin.g;
+            entry.sum[2] += bin.b;
+            entry.sum[3] += bin.a;
+        }
+        if (entry.count == 0) {
+            continue;
+        }
+        for (int c = 0; c < 3; ++c) {
+            entry.mean[c] = static_cast<int>(entry.sum[c] / entry.count);
+        }
+        entries.push_back(entry);
+    }
+
+    // Weighted median cut: split the box with the largest error at the pixel
+    // median of its widest axis until there are colorCount boxes
+    std::vector<QuantizeBox> boxes;
+    boxes.reserve(static_cast<size_t>(colorCount));
+    boxes.push_back(makeBox(entries, 0, entries.size()));
+    while (static_cast<int>(boxes.size()) < colorCount) {
+        size_t splitIndex = boxes.size();
+        double largestError = 0.0;
+        for (size_t i = 0; i < boxes.size(); ++i) {
+            if (boxes[i].end - boxes[i].begin > 1 && boxes[i].error > largestError) {
+                largestError = boxes[i].error;
+                splitIndex = i;
+            }
+        }
+        if (splitIndex == boxes.size()) {
+            break;  // Every box is a single bucket (or has no spread)
+        }
+
+        // Weighted median of the axis: channel means are 0-255, so count the box's
+        // pixels per value instead of sorting its entries
+        QuantizeBox box = boxes[splitIndex];
+        int axis = box.axis;
+        uint64_t axisCounts[256] = {};
+        for (size_t i = box.begin; i < box.end; ++i) {
+            axisCounts[entries[i].mean[axis]] += entries[i].count;
+        }
+        int median = 0;
+        uint64_t below = 0;  // Pixels with axis value < median
+        while (below + axisCounts[median] <= box.count / 2) {
+            below += axisCounts[median++];
+        }
+
+        // Entries under the median go first; the median value joins the lower half
+        // when nothing lies below it
+        int split = below > 0 ? median : median + 1;
+        auto midIt = std::partition(entries.begin() + box.begin, entries.begin() + box.end,
+                                    [axis, split](const HistogramEntry& e) { return e.mean[axis] < split; });
+        size_t mid = static_cast<size_t>(midIt - entries.begin());
+        if (mid == box.begin || mid == box.end) {
+            boxes[splitIndex].error = 0.0;  // Spread is below the 1/256 key resolution
+            continue;
+        }
+
+        boxes[splitIndex] = makeBox(entries, box.begin, mid);
+        boxes.push_back(makeBox(entries, mid, box.end));
+    }
+
+    for (size_t i = 0; i < boxes.size(); ++i) {
+        const QuantizeBox& box = boxes[i];
+        uint64_t round = box.count / 2;
+        palette.colors_[i] = Color{
+            static_cast<uint8_t>((box.sum[0] + round) / box.count),
+            static_cast<uint8_t>((box.sum[1] + round) / box.count),
+            static_cast<uint8_t>((box.sum[2] + round) / box.count),
+            static_cast<uint8_t>((box.sum[3] + round) / box.count)
+        };
+    }
+    return palette;
+}
+
 } // namespace Engine
@@ -1,7 +1,10 @@
 #include "engine/PixelBuffer.h"
 #include "engine/IRenderer.h"
+#include "engine/PixelKernels.h"
+#include "engine/Profiler.h"
 #include <SDL_image.h>
 #include <algorithm>
+#include <cstring>
 #include <iostream>
 
 namespace Engine {
@@ -54,31 +57,14 @@ bool PixelBuffer::loadFromFile(const std::string& imagePath, int destX, int dest
         return false;
     }
 
-    // Copy pixels from surface to buffer
+    // Copy pixels from surface to buffer (clipped). RGBA32 stores bytes
+    // R, G, B, A on every platform - the layout of Color
     SDL_LockSurface(convertedSurface);
-    Uint32* pixels = static_cast<Uint32*>(convertedSurface->pixels);
-
-    for (int y = 0; y < convertedSurface->h; ++y) {
-        for (int x = 0; x < convertedSurface->w; ++x) {
-            int bufX = destX + x;
-            int bufY = destY + y;
-
-            // Skip pixels outside buffer bounds
-            if (bufX < 0 || bufX >= width_ || bufY < 0 || bufY >= height_) {
-                continue;
-            }
-
-            // Extract RGBA components (RGBA32 format: 0xRRGGBBAA)
-            Uint32 pixel = pixels[y * convertedSurface->w + x];
-            Color color;
-            color.r = (pixel >> 24) & 0xFF;
-            color.g = (pixel >> 16) & 0xFF;
-            color.b = (pixel >> 8) & 0xFF;
-            color.a = pixel & 0xFF;
-
-            pixels_[bufY * width_ + bufX] = color;
-        }
-    }
+    static_assert(sizeof(Color) == 4, "Color must match SDL_PIXELFORMAT_RGBA32");
+    PixelBlitOptions copy;
+    copy.blend = PixelBlend::Copy;
+    blit(static_cast<const Color*>(convertedSurface->pixels), convertedSurface->w, convertedSurface->h,
+         convertedSurface->pitch / static_cast<int>(sizeof(Color)), destX, destY, copy);
 
     SDL_UnlockSurface(convertedSurface);
     SDL_FreeSurface(convertedSurface);
@@ -113,40 +99,8 @@ void PixelBuffer::drawText(const PixelFontPtr& font, const std::string& text, in
             continue;
         }
 
-        // Blit glyph to buffer with alpha blending
-        for (int gy = 0; gy < charHeight; ++gy) {
-            for (int gx = 0; gx < charWidth; ++gx) {
-                int bufX = cursorX + gx;
-                int bufY = cursorY + gy;
-
-                // Skip if out of bounds
-                if (bufX < 0 || bufX >= width_ || bufY < 0 || bufY >= height_) {
-                    continue;
-                }
-
-                const Color& glyphPixel = glyph[gy * charWidth + gx];
-
-                // Alpha blending: blend glyph onto existing pixel
-                if (glyphPixel.a > 0) {
-                    int bufIdx = bufY * width_ + bufX;
-                    Color& destPixel = pixels_[bufIdx];
-
-                    if (glyphPixel.a == 255) {
-                        // Fully opaque, just copy
-                        destPixel = glyphPixel;
-                    } else {
-                        // Alpha blend
-                        float alpha = glyphPixel.a / 255.0f;
-                        float invAlpha = 1.0f - alpha;
-
-                        destPixel.r = static_cast<uint8_t>(glyphPixel.r * alpha + destPixel.r * invAlpha);
-                        destPixel.g = static_cast<uint8_t>(glyphPixel.g * alpha + destPixel.g * invAlpha);
-                        destPixel.b = static_cast<uint8_t>(glyphPixel.b * alpha + destPixel.b * invAlpha);
-                        destPixel.a = std::min(255, static_cast<int>(glyphPixel.a + destPixel.a));
-                    }
-                }
-            }
-        }
+        // Composite the glyph through the alpha blitter (clipped, SIMD rows)
+        blit(glyph.data(), charWidth, charHeight, charWidth, cursorX, cursorY);
 
         // Advance cursor
         cursorX += charWidth;
@@ -155,7 +109,74 @@ void PixelBuffer::drawText(const PixelFontPtr& font, const std::string& text, in
     markDirty();
 }
 
+void PixelBuffer::blit(const PixelBuffer& source, int srcX, int srcY, int width, int height,
+                       int destX, int destY, const PixelBlitOptions& options) {
+    // Clip against the source, then the destination, moving both origins together
+    int x1 = std::max({0, -srcX, -destX});
+    int y1 = std::max({0, -srcY, -destY});
+    int x2 = std::min({width, source.width_ - srcX, width_ - destX});
+    int y2 = std::min({height, source.height_ - srcY, height_ - destY});
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+
+    const int count = x2 - x1;
+    const int rows = y2 - y1;
+    const Color* src = source.pixels_.data() + static_cast<ptrdiff_t>(srcY + y1) * source.width_ + srcX + x1;
+    ptrdiff_t srcPitch = source.width_;
+
+    if (&source == this) {
+        // Stage the source rows so overlapping blends read original pixels
+        blitScratch_.resize(static_cast<size_t>(count) * rows);
+        for (int y = 0; y < rows; ++y) {
+            std::memcpy(blitScratch_.data() + static_cast<size_t>(y) * count, src + y * srcPitch,
+                        sizeof(Color) * count);
+        }
+        src = blitScratch_.data();
+        srcPitch = count;
+    }
+
+    blitRows(src, srcPitch, destX + x1, destY + y1, count, rows, options);
+}
+
+void PixelBuffer::blit(const Color* pixels, int width, int height, int pitch, int destX, int destY,
+                       const PixelBlitOptions& options) {
+    if (!pixels) {
+        return;
+    }
+    int x1 = std::max(0, -destX);
+    int y1 = std::max(0, -destY);
+    int x2 = std::min(width, width_ - destX);
+    int y2 = std::min(height, height_ - destY);
+    if (x1 >= x2 || y1 >= y2) {
+        return;
+    }
+    blitRows(pixels + static_cast<ptrdiff_t>(y1) * pitch + x1, pitch, destX + x1, destY + y1, x2 - x1, y2 - y1,
+             options);
+}
+
+void PixelBuffer::blitRows(const Color* src, ptrdiff_t srcPitch, int destX, int destY, int width, int height,
+                           const PixelBlitOptions& options) {
+    Color* dest = pixels_.data() + static_cast<ptrdiff_t>(destY) * width_ + destX;
+    size_t count = static_cast<size_t>(width);
+    for (int y = 0; y < height; ++y, src += srcPitch, dest += width_) {
+        switch (options.blend) {
+            case PixelBlend::Copy:
+                std::memcpy(dest, src, sizeof(Color) * count);
+                break;
+            case PixelBlend::Alpha:
+                blendOverRGBA(src, dest, count, options.premultiplied);
+                break;
+            case PixelBlend::Additive:
+                blendAddRGBA(src, dest, count, options.premultiplied);
+                break;
+        }
+    }
+    dirty_ = true;
+}
+
 void PixelBuffer::upload(IRenderer& renderer) {
+    PROFILE_ZONE("PixelBuffer::upload");
     if (!dirty_) {
         return;  // No changes, skip upload
     }
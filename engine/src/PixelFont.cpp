@@ -175,6 +175,17 @@ const std::vector<Color>& PixelFont::getGlyph(char c) const {
     return emptyGlyph_;
 }
 
+size_t PixelFont::getMemoryUsage() const {
+    size_t bytes = 0;
+    for (const auto& [c, glyph] : glyphs_) {
+        bytes += glyph.capacity() * sizeof(Color);
+    }
+    for (const auto& [c, bitmask] : glyphBitmasks_) {
+        bytes += bitmask.capacity();
+    }
+    return bytes;
+}
+
 const std::vector<uint8_t>& PixelFont::getGlyphBitmask(char c) const {
     auto it = glyphBitmasks_.find(c);
     if (it != glyphBitmasks_.end()) {
@@ -0,0 +1,485 @@
+#include "engine/PixelKernels.h"
+#include <algorithm>
+#include <array>
+
+#if defined(__x86_64__) || defined(__i386__) || defined(_M_X64) || defined(_M_IX86)
+    #define ENGINE_KERNELS_X86 1
+    #include <immintrin.h>
+    #ifdef _MSC_VER
+        #include <intrin.h>
+    #endif
+#else
+    #define ENGINE_KERNELS_X86 0
+#endif
+
+// GCC/Clang compile each kernel for its own target; MSVC allows intrinsics anywhere
+#if ENGINE_KERNELS_X86 && (defined(__GNUC__) || defined(__clang__))
+    #define ENGINE_TARGET_AVX2 __attribute__((target("avx2")))
+#else
+    #define ENGINE_TARGET_AVX2
+#endif
+
+namespace Engine {
+
+static_assert(sizeof(Color) == 4, "Pixel kernels treat Color as a packed 32-bit value");
+
+namespace {
+
+// x / 255, rounded, for x in [0, 255 * 255] (the vector kernels use the same steps)
+inline int div255(int x) {
+    x += 128;
+    return (x + (x >> 8)) >> 8;
+}
+
+inline uint8_t addSaturate(int a, int b) {
+    return static_cast<uint8_t>(std::min(255, a + b));
+}
+
+template <bool Premultiplied>
+inline void blendOverPixel(const Color& s, Color& d) {
+    int inv = 255 - s.a;
+    if (Premultiplied) {
+        d = Color{addSaturate(s.r, div255(d.r * inv)), addSaturate(s.g, div255(d.g * inv)),
+                  addSaturate(s.b, div255(d.b * inv)), addSaturate(s.a, div255(d.a * inv))};
+    } else {
+        d = Color{static_cast<uint8_t>(div255(s.r * s.a + d.r * inv)), static_cast<uint8_t>(div255(s.g * s.a + d.g * inv)),
+                  static_cast<uint8_t>(div255(s.b * s.a + d.b * inv)), static_cast<uint8_t>(div255(s.a * 255 + d.a * inv))};
+    }
+}
+
+template <bool Premultiplied>
+inline void blendAddPixel(const Color& s, Color& d) {
+    int alpha = addSaturate(s.a, div255(d.a * (255 - s.a)));
+    if (Premultiplied) {
+        d = Color{addSaturate(d.r, s.r), addSaturate(d.g, s.g), addSaturate(d.b, s.b), static_cast<uint8_t>(alpha)};
+    } else {
+        d = Color{addSaturate(d.r, div255(s.r * s.a)), addSaturate(d.g, div255(s.g * s.a)),
+                  addSaturate(d.b, div255(s.b * s.a)), static_cast<uint8_t>(alpha)};
+    }
+}
+
+template <bool Premultiplied>
+void blendOverRGBARow(const Color* src, Color* dest, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        blendOverPixel<Premultiplied>(src[i], dest[i]);
+    }
+}
+
+template <bool Premultiplied>
+void blendAddRGBARow(const Color* src, Color* dest, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        blendAddPixel<Premultiplied>(src[i], dest[i]);
+    }
+}
+
+#if ENGINE_KERNELS_X86
+
+bool cpuHasAVX2() {
+#if defined(_MSC_VER) && !defined(__clang__)
+    int info[4];
+    __cpuid(info, 1);
+    bool osxsave = (info[2] & (1 << 27)) != 0;
+    bool avx = (info[2] & (1 << 28)) != 0;
+    if (!osxsave || !avx || (_xgetbv(0) & 0x6) != 0x6) {
+        return false;  // OS does not save YMM state
+    }
+    __cpuidex(info, 7, 0);
+    return (info[1] & (1 << 5)) != 0;
+#else
+    return __builtin_cpu_supports("avx2");
+#endif
+}
+
+ENGINE_TARGET_AVX2
+void expandIndexedAVX2(const uint8_t* indices, const Color* palette, Color* dest, size_t count) {
+    const int* table = reinterpret_cast<const int*>(palette);
+    size_t i = 0;
+
+    // 16 pixels per iteration: widen 8 indices to 32-bit lanes, gather 8 colors
+    for (; i + 16 <= count; i += 16) {
+        __m256i lo = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i)));
+        __m256i hi = _mm256_cvtepu8_epi32(_mm_loadl_epi64(reinterpret_cast<const __m128i*>(indices + i + 8)));
+        __m256i colorsLo = _mm256_i32gather_epi32(table, lo, 4);
+        __m256i colorsHi = _mm256_i32gather_epi32(table, hi, 4);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), colorsLo);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i + 8), colorsHi);
+    }
+
+    for (; i < count; ++i) {
+        dest[i] = palette[indices[i]];
+    }
+}
+
+ENGINE_TARGET_AVX2
+void blitMaskedIndexedAVX2(const uint8_t* src, uint8_t* dest, size_t count, uint8_t transparentIndex) {
+    const __m256i key = _mm256_set1_epi8(static_cast<char>(transparentIndex));
+    size_t i = 0;
+
+    // Keep dest where the source is transparent, take the source elsewhere
+    for (; i + 32 <= count; i += 32) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        __m256i d = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(dest + i));
+        __m256i transparent = _mm256_cmpeq_epi8(s, key);
+        _mm256_storeu_si256(reinterpret_cast<__m256i*>(dest + i), _mm256_blendv_epi8(s, d, transparent));
+    }
+
+    // Narrow sprites: one 16-pixel step before the scalar tail
+    if (i + 16 <= count) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+        __m128i transparent = _mm_cmpeq_epi8(s, _mm256_castsi256_si128(key));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), _mm_blendv_epi8(s, d, transparent));
+        i += 16;
+    }
+
+    for (; i < count; ++i) {
+        dest[i] = src[i] == transparentIndex ? dest[i] : src[i];
+    }
+}
+
+ENGINE_TARGET_AVX2
+void shadeIndexedAVX2(uint8_t* pixels, const uint8_t* light, const uint8_t* table, size_t count) {
+    const int* words = reinterpret_cast<const int*>(table);
+    const __m256i lowByte = _mm256_set1_epi32(0xFF);
+    size_t i = 0;
+
+    // 16 pixels per iteration: (light << 8 | index) byte offsets, two gathers,
+    // then pack the low byte of each 32-bit lane back down to 16 bytes
+    for (; i + 16 <= count; i += 16) {
+        __m128i p = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pixels + i));
+        __m128i l = _mm_loadu_si128(reinterpret_cast<const __m128i*>(light + i));
+        __m256i offsetsLo = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu8_epi32(l), 8), _mm256_cvtepu8_epi32(p));
+        __m256i offsetsHi = _mm256_or_si256(_mm256_slli_epi32(_mm256_cvtepu8_epi32(_mm_srli_si128(l, 8)), 8),
+                                            _mm256_cvtepu8_epi32(_mm_srli_si128(p, 8)));
+        __m256i lo = _mm256_and_si256(_mm256_i32gather_epi32(words, offsetsLo, 1), lowByte);
+        __m256i hi = _mm256_and_si256(_mm256_i32gather_epi32(words, offsetsHi, 1), lowByte);
+        __m256i packed16 = _mm256_permute4x64_epi64(_mm256_packus_epi32(lo, hi), 0xD8);
+        __m128i packed8 = _mm_packus_epi16(_mm256_castsi256_si128(packed16), _mm256_extracti128_si256(packed16, 1));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(pixels + i), packed8);
+    }
+
+    for (; i < count; ++i) {
+        pixels[i] = table[(light[i] << 8) | pixels[i]];
+    }
+}
+
+// RGBA blending on 16-bit lanes: each 32-byte vector holds 8 pixels, unpacked
+// into two halves of 4 pixels x 4 channels. Per pixel, "alpha" carries the source
+// alpha in all four channels and "factor" carries it in r, g, b and 255 in a, so
+// one multiply weights the colors and keeps src.a * 255 for the alpha channel.
+ENGINE_TARGET_AVX2
+inline __m256i div255AVX2(__m256i x) {
+    x = _mm256_add_epi16(x, _mm256_set1_epi16(128));
+    return _mm256_srli_epi16(_mm256_add_epi16(x, _mm256_srli_epi16(x, 8)), 8);
+}
+
+ENGINE_TARGET_AVX2
+inline __m256i broadcastAlphaAVX2(__m256i pixels16) {
+    return _mm256_shufflehi_epi16(_mm256_shufflelo_epi16(pixels16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+}
+
+template <bool Over, bool Premultiplied>
+ENGINE_TARGET_AVX2 inline __m256i blendRGBA8AVX2(__m256i s, __m256i d) {
+    const __m256i zero = _mm256_setzero_si256();
+    const __m256i full = _mm256_set1_epi16(255);
+    const __m256i alphaLanes = _mm256_set1_epi64x(static_cast<long long>(0x00FF000000000000ull));
+    __m256i destTerms[2];
+    __m256i srcTerms[2];
+    for (int h = 0; h < 2; ++h) {
+        __m256i s16 = h == 0 ? _mm256_unpacklo_epi8(s, zero) : _mm256_unpackhi_epi8(s, zero);
+        __m256i d16 = h == 0 ? _mm256_unpacklo_epi8(d, zero) : _mm256_unpackhi_epi8(d, zero);
+        __m256i alpha = broadcastAlphaAVX2(s16);
+        __m256i inv = _mm256_sub_epi16(full, alpha);
+        __m256i factor = _mm256_or_si256(alpha, alphaLanes);
+        // Over fades every dest channel by 1 - src.a; Add keeps dest r, g, b
+        __m256i destFactor = Over ? inv : _mm256_or_si256(_mm256_andnot_si256(alphaLanes, full),
+                                                          _mm256_and_si256(alphaLanes, inv));
+        __m256i weighted = _mm256_mullo_epi16(d16, destFactor);
+        if (Over && !Premultiplied) {
+            // One rounding for src * a + dest * (1 - a), as in the scalar kernel
+            destTerms[h] = div255AVX2(_mm256_add_epi16(weighted, _mm256_mullo_epi16(s16, factor)));
+        } else {
+            destTerms[h] = div255AVX2(weighted);
+            if (!Premultiplied) {
+                srcTerms[h] = div255AVX2(_mm256_mullo_epi16(s16, factor));
+            }
+        }
+    }
+    __m256i result = _mm256_packus_epi16(destTerms[0], destTerms[1]);
+    if (Premultiplied) {
+        return _mm256_adds_epu8(s, result);
+    }
+    if (!Over) {
+        return _mm256_adds_epu8(_mm256_packus_epi16(srcTerms[0], srcTerms[1]), result);
+    }
+    return result;
+}
+
+template <bool Over, bool Premultiplied>
+ENGINE_TARGET_AVX2 void blendRGBAAVX2(const Color* src, Color* dest, size_t count) {
+    const __m256i alphaMask = _mm256_set1_epi32(static_cast<int>(0xFF000000u));
+    // Straight sources with zero alpha leave dest unchanged; premultiplied ones
+    // only when they are all zero (additive light may have color without alpha)
+    const __m256i visibleMask = Premultiplied ? _mm256_set1_epi32(-1) : alphaMask;
+
+    size_t i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256i s = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i));
+        if (_mm256_testz_si256(s, visibleMask)) {
+            continue;
+        }
+        __m256i* d = reinterpret_cast<__m256i*>(dest + i);
+        bool opaque = Over && _mm256_movemask_epi8(_mm256_cmpeq_epi32(_mm256_and_si256(s, alphaMask), alphaMask)) == -1;
+        _mm256_storeu_si256(d, opaque ? s : blendRGBA8AVX2<Over, Premultiplied>(s, _mm256_loadu_si256(d)));
+    }
+
+    // 1-7 trailing pixels: masked loads read zeros past the end, masked stores skip them
+    if (i < count) {
+        const __m256i lane = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_set1_epi32(static_cast<int>(count - i)), lane);
+        int* d = reinterpret_cast<int*>(dest + i);
+        __m256i s = _mm256_maskload_epi32(reinterpret_cast<const int*>(src + i), mask);
+        if (!_mm256_testz_si256(s, visibleMask)) {
+            _mm256_maskstore_epi32(d, mask, blendRGBA8AVX2<Over, Premultiplied>(s, _mm256_maskload_epi32(d, mask)));
+        }
+    }
+}
+
+#endif // ENGINE_KERNELS_X86
+
+// SSE2 is part of the x86-64 baseline, so this path needs no runtime check
+#if ENGINE_KERNELS_X86 && (defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2))
+    #define ENGINE_KERNELS_SSE2 1
+#else
+    #define ENGINE_KERNELS_SSE2 0
+#endif
+
+#if ENGINE_KERNELS_SSE2
+
+void blitMaskedIndexedSSE2(const uint8_t* src, uint8_t* dest, size_t count, uint8_t transparentIndex) {
+    const __m128i key = _mm_set1_epi8(static_cast<char>(transparentIndex));
+    size_t i = 0;
+
+    for (; i + 16 <= count; i += 16) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i d = _mm_loadu_si128(reinterpret_cast<const __m128i*>(dest + i));
+        __m128i transparent = _mm_cmpeq_epi8(s, key);
+        __m128i blended = _mm_or_si128(_mm_and_si128(transparent, d), _mm_andnot_si128(transparent, s));
+        _mm_storeu_si128(reinterpret_cast<__m128i*>(dest + i), blended);
+    }
+
+    for (; i < count; ++i) {
+        dest[i] = src[i] == transparentIndex ? dest[i] : src[i];
+    }
+}
+
+inline __m128i div255SSE2(__m128i x) {
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// 4 pixels per step, the same lane layout as blendRGBA8AVX2
+template <bool Over, bool Premultiplied>
+inline __m128i blendRGBA4SSE2(__m128i s, __m128i d) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i full = _mm_set1_epi16(255);
+    const __m128i alphaLanes = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+    __m128i destTerms[2];
+    __m128i srcTerms[2];
+    for (int h = 0; h < 2; ++h) {
+        __m128i s16 = h == 0 ? _mm_unpacklo_epi8(s, zero) : _mm_unpackhi_epi8(s, zero);
+        __m128i d16 = h == 0 ? _mm_unpacklo_epi8(d, zero) : _mm_unpackhi_epi8(d, zero);
+        __m128i alpha = _mm_shufflehi_epi16(_mm_shufflelo_epi16(s16, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+        __m128i inv = _mm_sub_epi16(full, alpha);
+        __m128i factor = _mm_or_si128(alpha, alphaLanes);
+        __m128i destFactor = Over ? inv : _mm_or_si128(_mm_andnot_si128(alphaLanes, full), _mm_and_si128(alphaLanes, inv));
+        __m128i weighted = _mm_mullo_epi16(d16, destFactor);
+        if (Over && !Premultiplied) {
+            destTerms[h] = div255SSE2(_mm_add_epi16(weighted, _mm_mullo_epi16(s16, factor)));
+        } else {
+            destTerms[h] = div255SSE2(weighted);
+            if (!Premultiplied) {
+                srcTerms[h] = div255SSE2(_mm_mullo_epi16(s16, factor));
+            }
+        }
+    }
+    __m128i result = _mm_packus_epi16(destTerms[0], destTerms[1]);
+    if (Premultiplied) {
+        return _mm_adds_epu8(s, result);
+    }
+    if (!Over) {
+        return _mm_adds_epu8(_mm_packus_epi16(srcTerms[0], srcTerms[1]), result);
+    }
+    return result;
+}
+
+template <bool Over, bool Premultiplied>
+void blendRGBASSE2(const Color* src, Color* dest, size_t count) {
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alphaMask = _mm_set1_epi32(static_cast<int>(0xFF000000u));
+    const __m128i visibleMask = Premultiplied ? _mm_set1_epi32(-1) : alphaMask;
+    size_t i = 0;
+
+    for (; i + 4 <= count; i += 4) {
+        __m128i s = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i));
+        __m128i visible = _mm_and_si128(s, visibleMask);
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(visible, zero)) == 0xFFFF) {
+            continue;
+        }
+        __m128i* d = reinterpret_cast<__m128i*>(dest + i);
+        bool opaque = Over && _mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(s, alphaMask), alphaMask)) == 0xFFFF;
+        _mm_storeu_si128(d, opaque ? s : blendRGBA4SSE2<Over, Premultiplied>(s, _mm_loadu_si128(d)));
+    }
+
+    for (; i < count; ++i) {
+        if (Over) {
+            blendOverPixel<Premultiplied>(src[i], dest[i]);
+        } else {
+            blendAddPixel<Premultiplied>(src[i], dest[i]);
+        }
+    }
+}
+
+#endif // ENGINE_KERNELS_SSE2
+
+using ExpandIndexedFn = void (*)(const uint8_t*, const Color*, Color*, size_t);
+
+SimdLevel detectSimdLevel() {
+#if ENGINE_KERNELS_X86
+    if (cpuHasAVX2()) {
+        return SimdLevel::AVX2;
+    }
+#endif
+    return SimdLevel::Scalar;
+}
+
+ExpandIndexedFn selectExpandIndexed() {
+#if ENGINE_KERNELS_X86
+    if (getSimdLevel() == SimdLevel::AVX2) {
+        return expandIndexedAVX2;
+    }
+#endif
+    return expandIndexedScalar;
+}
+
+using BlitMaskedIndexedFn = void (*)(const uint8_t*, uint8_t*, size_t, uint8_t);
+
+BlitMaskedIndexedFn selectBlitMaskedIndexed() {
+#if ENGINE_KERNELS_X86
+    if (getSimdLevel() == SimdLevel::AVX2) {
+        return blitMaskedIndexedAVX2;
+    }
+#endif
+#if ENGINE_KERNELS_SSE2
+    return blitMaskedIndexedSSE2;
+#else
+    return blitMaskedIndexedScalar;
+#endif
+}
+
+using ShadeIndexedFn = void (*)(uint8_t*, const uint8_t*, const uint8_t*, size_t);
+
+ShadeIndexedFn selectShadeIndexed() {
+#if ENGINE_KERNELS_X86
+    if (getSimdLevel() == SimdLevel::AVX2) {
+        return shadeIndexedAVX2;
+    }
+#endif
+    return shadeIndexedScalar;
+}
+
+using BlendRGBAFn = void (*)(const Color*, Color*, size_t);
+
+// Kernels for straight [0] and premultiplied [1] sources
+template <bool Over>
+std::array<BlendRGBAFn, 2> selectBlendRGBA() {
+#if ENGINE_KERNELS_X86
+    if (getSimdLevel() == SimdLevel::AVX2) {
+        return {blendRGBAAVX2<Over, false>, blendRGBAAVX2<Over, true>};
+    }
+#endif
+#if ENGINE_KERNELS_SSE2
+    return {blendRGBASSE2<Over, false>, blendRGBASSE2<Over, true>};
+#else
+    if (Over) {
+        return {blendOverRGBARow<false>, blendOverRGBARow<true>};
+    }
+    return {blendAddRGBARow<false>, blendAddRGBARow<true>};
+#endif
+}
+
+} // anonymous namespace
+
+SimdLevel getSimdLevel() {
+    static const SimdLevel level = detectSimdLevel();
+    return level;
+}
+
+const char* toString(SimdLevel level) {
+    switch (level) {
+        case SimdLevel::Scalar: return "scalar";
+        case SimdLevel::AVX2:   return "avx2";
+    }
+    return "unknown";
+}
+
+void expandIndexedScalar(const uint8_t* indices, const Color* palette, Color* dest, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        dest[i] = palette[indices[i]];
+    }
+}
+
+void expandIndexed(const uint8_t* indices, const Color* palette, Color* dest, size_t count) {
+    static const ExpandIndexedFn kernel = selectExpandIndexed();
+    kernel(indices, palette, dest, count);
+}
+
+void blitMaskedIndexedScalar(const uint8_t* src, uint8_t* dest, size_t count, uint8_t transparentIndex) {
+    for (size_t i = 0; i < count; ++i) {
+        dest[i] = src[i] == transparentIndex ? dest[i] : src[i];
+    }
+}
+
+void blitMaskedIndexed(const uint8_t* src, uint8_t* dest, size_t count, uint8_t transparentIndex) {
+    static const BlitMaskedIndexedFn kernel = selectBlitMaskedIndexed();
+    kernel(src, dest, count, transparentIndex);
+}
+
+void shadeIndexedScalar(uint8_t* pixels, const uint8_t* light, const uint8_t* table, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+        pixels[i] = table[(light[i] << 8) | pixels[i]];
+    }
+}
+
+void shadeIndexed(uint8_t* pixels, const uint8_t* light, const uint8_t* table, size_t count) {
+    static const ShadeIndexedFn kernel = selectShadeIndexed();
+    kernel(pixels, light, table, count);
+}
+
+void blendOverRGBAScalar(const Color* src, Color* dest, size_t count, bool premultiplied) {
+    if (premultiplied) {
+        blendOverRGBARow<true>(src, dest, count);
+    } else {
+        blendOverRGBARow<false>(src, dest, count);
+    }
+}
+
+void blendOverRGBA(const Color* src, Color* dest, size_t count, bool premultiplied) {
+    static const std::array<BlendRGBAFn, 2> kernels = selectBlendRGBA<true>();
+    kernels[premultiplied ? 1 : 0](src, dest, count);
+}
+
+void blendAddRGBAScalar(const Color* src, Color* dest, size_t count, bool premultiplied) {
+    if (premultiplied) {
+        blendAddRGBARow<true>(src, dest, count);
+    } else {
+        blendAddRGBARow<false>(src, dest, count);
+    }
+}
+
+void blendAddRGBA(const Color* src, Color* dest, size_t count, bool premultiplied) {
+    static const std::array<BlendRGBAFn, 2> kernels = selectBlendRGBA<false>();
+    kernels[premultiplied ? 1 : 0](src, dest, count);
+}
+
+} // namespace Engine
@@ -0,0 +1,145 @@
+#include "engine/Profiler.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+
+namespace Engine {
+
+namespace {
+
+// Per-thread pointer into the profiler's registry (set on first recorded zone)
+thread_local void* tlsThreadBuffer = nullptr;
+
+void writeEscaped(std::ostream& out, const char* text) {
+    for (const char* p = text; *p; ++p) {
+        switch (*p) {
+            case '"':  out << "\\\""; break;
+            case '\\': out << "\\\\"; break;
+            case '\n': out << "\\n"; break;
+            default:   out << *p; break;
+        }
+    }
+}
+
+// Chrome trace timestamps are microseconds; keep nanosecond resolution as fraction
+void writeMicroseconds(std::ostream& out, uint64_t ns) {
+    char buf[32];
+    std::snprintf(buf, sizeof(buf), "%llu.%03llu",
+                  static_cast<unsigned long long>(ns / 1000),
+                  static_cast<unsigned long long>(ns % 1000));
+    out << buf;
+}
+
+} // anonymous namespace
+
+uint64_t Profiler::nowNs() {
+    return static_cast<uint64_t>(std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count());
+}
+
+Profiler::ThreadBuffer& Profiler::getThreadBuffer() {
+    if (tlsThreadBuffer) {
+        return *static_cast<ThreadBuffer*>(tlsThreadBuffer);
+    }
+
+    // First zone on this thread: allocate its ring buffer once
+    auto buffer = std::make_unique<ThreadBuffer>();
+    buffer->events.resize(kEventsPerThread);
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer->threadId = static_cast<uint32_t>(threads_.size() + 1);
+    buffer->name = "Thread " + std::to_string(buffer->threadId);
+    tlsThreadBuffer = buffer.get();
+    threads_.push_back(std::move(buffer));
+    return *threads_.back();
+}
+
+void Profiler::recordZone(const char* name, uint64_t startNs, uint64_t endNs) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    uint64_t index = buffer.writeIndex.load(std::memory_order_relaxed);
+
+    Event& event = buffer.events[index & (kEventsPerThread - 1)];
+    event.name = name;
+    event.startNs = startNs;
+    event.endNs = endNs;
+
+    // Publish after the event is written so readers never see a half-written slot
+    buffer.writeIndex.store(index + 1, std::memory_order_release);
+}
+
+void Profiler::setThreadName(const std::string& name) {
+    ThreadBuffer& buffer = getThreadBuffer();
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    buffer.name = name;
+}
+
+void Profiler::clear() {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    for (auto& buffer : threads_) {
+        buffer->writeIndex.store(0, std::memory_order_release);
+    }
+}
+
+size_t Profiler::getEventCount() const {
+    std::lock_guard<std::mutex> lock(registryMutex_);
+    size_t count = 0;
+    for (const auto& buffer : threads_) {
+        uint64_t written = buffer->writeIndex.load(std::memory_order_acquire);
+        count += static_cast<size_t>(std::min<uint64_t>(written, kEventsPerThread));
+    }
+    return count;
+}
+
+bool Profiler::writeChromeTrace(const std::string& path) const {
+    std::ofstream out(path);
+    if (!out) {
+        std::cerr << "Profiler: failed to open trace file " << path << std::endl;
+        return false;
+    }
+
+    std::lock_guard<std::mutex> lock(registryMutex_);
+
+    out << "{\"displayTimeUnit\":\"ns\",\"traceEvents\":[\n";
+    bool first = true;
+
+    for (const auto& buffer : threads_) {
+        // Thread name metadata
+        if (!first) out << ",\n";
+        first = false;
+        out << "{\"ph\":\"M\",\"name\":\"thread_name\",\"pid\":1,\"tid\":" << buffer->threadId
+            << ",\"args\":{\"name\":\"";
+        writeEscaped(out, buffer->name.c_str());
+        out << "\"}}";
+
+        // Oldest surviving event first
+        uint64_t end = buffer->writeIndex.load(std::memory_order_acquire);
+        uint64_t begin = end > kEventsPerThread ? end - kEventsPerThread : 0;
+
+        for (uint64_t i = begin; i < end; ++i) {
+            const Event& event = buffer->events[i & (kEventsPerThread - 1)];
+            if (!event.name) continue;
+
+            uint64_t start = event.startNs > epochNs_ ? event.startNs - epochNs_ : 0;
+            out << ",\n{\"name\":\"";
+            writeEscaped(out, event.name);
+            out << "\",\"pid\":1,\"tid\":" << buffer->threadId << ",\"ts\":";
+            writeMicroseconds(out, start);
+
+            if (event.endNs == event.startNs) {
+                // Instant event, global scope so it spans all threads (frame markers)
+                out << ",\"ph\":\"i\",\"s\":\"g\"}";
+            } else {
+                out << ",\"ph\":\"X\",\"dur\":";
+                writeMicroseconds(out, event.endNs - event.startNs);
+                out << "}";
+            }
+        }
+    }
+
+    out << "\n]}\n";
+    return static_cast<bool>(out);
+}
+
+} // namespace Engine
@@ -0,0 +1,160 @@
+#include "engine/Replay.h"
+#include "engine/Engine.h"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+namespace Engine {
+
+namespace {
+    // Parse the value following a flag, advancing i; false if missing or malformed
+    bool nextInt(int argc, char* argv[], int& i, long& out) {
+        if (i + 1 >= argc) return false;
+        char* end = nullptr;
+        out = std::strtol(argv[++i], &end, 10);
+        return end && *end == '\0';
+    }
+
+    bool nextFloat(int argc, char* argv[], int& i, float& out) {
+        if (i + 1 >= argc) return false;
+        char* end = nullptr;
+        out = std::strtof(argv[++i], &end);
+        return end && *end == '\0';
+    }
+}
+
+bool parseReplayArgs(int argc, char* argv[], EngineConfig& config) {
+    ReplayConfig& replay = config.replay;
+
+    for (int i = 1; i < argc; ++i) {
+        const char* arg = argv[i];
+        long value = 0;
+
+        if (std::strcmp(arg, "--replay") == 0) {
+            if (!nextInt(argc, argv, i, value) || value <= 0) {
+                std::cerr << "--replay expects a positive frame count" << std::endl;
+                return false;
+            }
+            replay.frames = static_cast<int>(value);
+        } else if (std::strcmp(arg, "--replay-dt") == 0) {
+            if (!nextFloat(argc, argv, i, replay.deltaTime) || replay.deltaTime <= 0.0f) {
+                std::cerr << "--replay-dt expects a positive number of seconds" << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--replay-seed") == 0) {
+            if (!nextInt(argc, argv, i, value)) {
+                std::cerr << "--replay-seed expects an integer" << std::endl;
+                return false;
+            }
+            replay.seed = static_cast<uint32_t>(value);
+        } else if (std::strcmp(arg, "--replay-report") == 0) {
+            if (i + 1 >= argc) {
+                std::cerr << "--replay-report expects a path" << std::endl;
+                return false;
+            }
+            replay.reportPath = argv[++i];
+        } else if (std::strcmp(arg, "--no-vsync") == 0) {
+            config.vsync = false;
+        }
+    }
+    return true;
+}
+
+uint64_t hashPixels(const std::vector<Color>& pixels) {
+    uint64_t hash = 14695981039346656037ull;  // FNV offset basis
+    for (const Color& c : pixels) {
+        const uint8_t bytes[4] = {c.r, c.g, c.b, c.a};
+        for (uint8_t byte : bytes) {
+            hash ^= byte;
+            hash *= 1099511628211ull;  // FNV prime
+        }
+    }
+    return hash;
+}
+
+ReplayRecorder::ReplayRecorder(const ReplayConfig& config)
+    : config_(config)
+    , stats_(static_cast<size_t>(std::max(config.frames, 1)), config.deltaTime * 1000.0f)
+    , counterToMs_(1000.0 / static_cast<double>(SDL_GetPerformanceFrequency())) {
+    frameTimes_.reserve(static_cast<size_t>(std::max(config.frames, 0)));
+}
+
+void ReplayRecorder::beginFrame() {
+    frameStart_ = SDL_GetPerformanceCounter();
+}
+
+void ReplayRecorder::endFrame() {
+    if (isFinished()) {
+        return;
+    }
+
+    float frameMs = static_cast<float>((SDL_GetPerformanceCounter() - frameStart_) * counterToMs_);
+    frameTimes_.push_back(frameMs);
+    stats_.addSample(frameMs);
+    ++framesRecorded_;
+}
+
+void ReplayRecorder::setFinalFrame(const std::vector<Color>& pixels, int width, int height) {
+    hasFinalFrame_ = true;
+    finalHash_ = hashPixels(pixels);
+    finalWidth_ = width;
+    finalHeight_ = height;
+}
+
+bool ReplayRecorder::writeReport(const std::string& title, bool vsync) const {
+    std::ofstream out(config_.reportPath);
+    if (!out) {
+        std::cerr << "Replay: failed to open report file " << config_.reportPath << std::endl;
+        return false;
+    }
+
+    FrameStats::Summary summary = stats_.getSummary();
+    double totalMs = 0.0;
+    for (float ms : frameTimes_) {
+        totalMs += ms;
+    }
+
+    // Titles are plain ASCII in the examples; escape the JSON specials anyway
+    out << "{\n  \"title\": \"";
+    for (char c : title) {
+        if (c == '"' || c == '\\') out << '\\';
+        out << c;
+    }
+    out << "\",\n";
+    out << "  \"frames\": " << framesRecorded_ << ",\n";
+    out << "  \"deltaTime\": " << config_.deltaTime << ",\n";
+    out << "  \"seed\": " << config_.seed << ",\n";
+    out << "  \"vsync\": " << (vsync ? "true" : "false") << ",\n";
+    out << "  \"totalMs\": " << totalMs << ",\n";
+    out << "  \"summary\": {\"meanMs\": " << summary.meanMs
+        << ", \"minMs\": " << summary.minMs
+        << ", \"p50Ms\": " << summary.p50Ms
+        << ", \"p95Ms\": " << summary.p95Ms
+        << ", \"p99Ms\": " << summary.p99Ms
+        << ", \"maxMs\": " << summary.maxMs
+        << ", \"hitches\": " << summary.hitches << "},\n";
+
+    // 64-bit hash as a hex string - JSON numbers lose precision past 2^53
+    out << "  \"framebuffer\": ";
+    if (hasFinalFrame_) {
+        out << "{\"width\": " << finalWidth_ << ", \"height\": " << finalHeight_
+            << ", \"hash\": \"" << std::hex << std::setw(16) << std::setfill('0') << finalHash_
+            << std::dec << std::setfill(' ') << "\"},\n";
+    } else {
+        out << "null,\n";
+    }
+
+    out << "  \"frameTimesMs\": [";
+    for (size_t i = 0; i < frameTimes_.size(); ++i) {
+        if (i > 0) out << ", ";
+        out << frameTimes_[i];
+    }
+    out << "]\n}\n";
+
+    return static_cast<bool>(out);
+}
+
+} // namespace Engine
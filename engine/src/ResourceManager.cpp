@@ -2,6 +2,7 @@
 #include "engine/IRenderer.h"
 #include "engine/Logger.h"
 #include <nlohmann/json.hpp>
+#include <algorithm>
 #include <fstream>
 #include <sstream>
 
@@ -9,6 +10,69 @@ using json = nlohmann::json;
 
 namespace Engine {
 
+namespace {
+    // Backends allocate uncompressed RGBA8 textures
+    ResourceMemory measureTexture(const Texture& texture) {
+        ResourceMemory memory;
+        memory.gpuBytes = static_cast<size_t>(texture.getWidth()) * texture.getHeight() * sizeof(Color);
+        return memory;
+    }
+
+    // SDL_ttf streams the font file; its size is the best cheap estimate
+    ResourceMemory measureFont(const std::string& path) {
+        ResourceMemory memory;
+        std::ifstream file(path, std::ios::binary | std::ios::ate);
+        if (file) {
+            memory.cpuBytes = static_cast<size_t>(file.tellg());
+        }
+        return memory;
+    }
+
+    ResourceMemory measureTilemap(const Tilemap& tilemap) {
+        ResourceMemory memory;
+        memory.cpuBytes = sizeof(Tilemap) + static_cast<size_t>(tilemap.getWidth()) * tilemap.getHeight() * sizeof(int);
+        return memory;
+    }
+
+    ResourceMemory measurePalette(const Palette&) {
+        // Colors only: the inverse and blend tables are built lazily after the
+        // palette is cached (blend tables shared by content), so budgets skip them
+        ResourceMemory memory;
+        memory.cpuBytes = sizeof(Palette);
+        return memory;
+    }
+
+    ResourceMemory measurePixelFont(const PixelFont& font) {
+        ResourceMemory memory;
+        memory.cpuBytes = sizeof(PixelFont) + font.getMemoryUsage();
+        return memory;
+    }
+
+    ResourceMemory measureMesh(const Mesh3D& mesh) {
+        ResourceMemory memory;
+        memory.cpuBytes = sizeof(Mesh3D)
+                        + mesh.getVertices().capacity() * sizeof(Vec3)
+                        + mesh.getNormals().capacity() * sizeof(Vec3);
+        for (const auto& poly : mesh.getPolygons()) {
+            memory.cpuBytes += sizeof(Polygon)
+                             + (poly.vertices.capacity() + poly.normals.capacity()) * sizeof(int);
+        }
+        return memory;
+    }
+}
+
+const char* toString(ResourceCategory category) {
+    switch (category) {
+        case ResourceCategory::Texture:   return "texture";
+        case ResourceCategory::Font:      return "font";
+        case ResourceCategory::Tilemap:   return "tilemap";
+        case ResourceCategory::Palette:   return "palette";
+        case ResourceCategory::PixelFont: return "pixel font";
+        case ResourceCategory::Mesh:      return "mesh";
+        default:                          return "unknown";
+    }
+}
+
 ResourceManager::ResourceManager(const std::string& basePath)
     : basePath_(basePath) {
 }
@@ -60,6 +124,10 @@ TexturePtr ResourceManager::loadTexture(const std::string& name, const std::stri
         return nullptr;
     }
 
+    if (!trackMemory(ResourceCategory::Texture, name, measureTexture(*texture))) {
+        return nullptr;
+    }
+
     // Cache and return
     textures_[name] = texture;
     LOG_INFO_FMT("Loaded texture '%s' from '%s'", name.c_str(), fullPath.c_str());
@@ -83,6 +151,7 @@ void ResourceManager::unloadTexture(const std::string& name) {
     if (it != textures_.end()) {
         LOG_DEBUG_FMT("Unloading texture '%s'", name.c_str());
         textures_.erase(it);
+        untrackMemory(ResourceCategory::Texture, name);
     }
 }
 
@@ -105,6 +174,10 @@ FontPtr ResourceManager::loadFont(const std::string& name, const std::string& re
         return nullptr;
     }
 
+    if (!trackMemory(ResourceCategory::Font, name, measureFont(fullPath))) {
+        return nullptr;
+    }
+
     // Cache and return
     fonts_[name] = font;
     LOG_INFO_FMT("Loaded font '%s' from '%s' at size %d", name.c_str(), fullPath.c_str(), size);
@@ -128,6 +201,7 @@ void ResourceManager::unloadFont(const std::string& name) {
     if (it != fonts_.end()) {
         LOG_DEBUG_FMT("Unloading font '%s'", name.c_str());
         fonts_.erase(it);
+        untrackMemory(ResourceCategory::Font, name);
     }
 }
 
@@ -298,6 +372,10 @@ std::shared_ptr<Tilemap> ResourceManager::loadLDtkTilemap(
         }
     }
 
+    if (!trackMemory(ResourceCategory::Tilemap, name, measureTilemap(*tilemap))) {
+        return nullptr;
+    }
+
     // Cache and return
     tilemaps_[name] = tilemap;
     LOG_INFO_FMT("Loaded LDtk tilemap '%s' from '%s' (level: %s, layer: %s) - %dx%d tiles",
@@ -325,6 +403,7 @@ void ResourceManager::unloadTilemap(const std::string& name) {
     if (it != tilemaps_.end()) {
         LOG_DEBUG_FMT("Unloading tilemap '%s'", name.c_str());
         tilemaps_.erase(it);
+        untrackMemory(ResourceCategory::Tilemap, name);
     }
 }
 
@@ -347,6 +426,10 @@ PalettePtr ResourceManager::loadPalette(const std::string& name, const std::stri
         return nullptr;
     }
 
+    if (!trackMemory(ResourceCategory::Palette, name, measurePalette(*palette))) {
+        return nullptr;
+    }
+
     // Cache and return
     palettes_[name] = palette;
     LOG_INFO_FMT("Loaded palette '%s' from '%s'", name.c_str(), fullPath.c_str());
@@ -370,11 +453,15 @@ void ResourceManager::unloadPalette(const std::string& name) {
     if (it != palettes_.end()) {
         LOG_DEBUG_FMT("Unloading palette '%s'", name.c_str());
         palettes_.erase(it);
+        untrackMemory(ResourceCategory::Palette, name);
     }
 }
 
 PalettePtr ResourceManager::createGrayscalePalette(const std::string& name) {
     auto palette = std::make_shared<Palette>(Palette::createGrayscale());
+    if (!trackMemory(ResourceCategory::Palette, name, measurePalette(*palette))) {
+        return nullptr;
+    }
     palettes_[name] = palette;
     LOG_INFO_FMT("Created grayscale palette '%s'", name.c_str());
     return palette;
@@ -382,6 +469,9 @@ PalettePtr ResourceManager::createGrayscalePalette(const std::string& name) {
 
 PalettePtr ResourceManager::createVGAPalette(const std::string& name) {
     auto palette = std::make_shared<Palette>(Palette::createVGA());
+    if (!trackMemory(ResourceCategory::Palette, name, measurePalette(*palette))) {
+        return nullptr;
+    }
     palettes_[name] = palette;
     LOG_INFO_FMT("Created VGA palette '%s'", name.c_str());
     return palette;
@@ -389,6 +479,9 @@ PalettePtr ResourceManager::createVGAPalette(const std::string& name) {
 
 PalettePtr ResourceManager::createFirePalette(const std::string& name) {
     auto palette = std::make_shared<Palette>(Palette::createFireGradient());
+    if (!trackMemory(ResourceCategory::Palette, name, measurePalette(*palette))) {
+        return nullptr;
+    }
     palettes_[name] = palette;
     LOG_INFO_FMT("Created fire palette '%s'", name.c_str());
     return palette;
@@ -396,6 +489,9 @@ PalettePtr ResourceManager::createFirePalette(const std::string& name) {
 
 PalettePtr ResourceManager::createRainbowPalette(const std::string& name) {
     auto palette = std::make_shared<Palette>(Palette::createRainbow());
+    if (!trackMemory(ResourceCategory::Palette, name, measurePalette(*palette))) {
+        return nullptr;
+    }
     palettes_[name] = palette;
     LOG_INFO_FMT("Created rainbow palette '%s'", name.c_str());
     return palette;
@@ -427,6 +523,10 @@ PixelFontPtr ResourceManager::loadPixelFont(const std::string& name,
         return nullptr;
     }
 
+    if (!trackMemory(ResourceCategory::PixelFont, name, measurePixelFont(*pixelFont))) {
+        return nullptr;
+    }
+
     // Cache and return
     pixelFonts_[name] = pixelFont;
     LOG_INFO_FMT("Loaded pixel font '%s' from '%s' (%dx%d chars)",
@@ -456,6 +556,10 @@ PixelFontPtr ResourceManager::loadPixelFontBinary(const std::string& name,
         return nullptr;
     }
 
+    if (!trackMemory(ResourceCategory::PixelFont, name, measurePixelFont(*pixelFont))) {
+        return nullptr;
+    }
+
     // Cache and return
     pixelFonts_[name] = pixelFont;
     LOG_INFO_FMT("Loaded binary pixel font '%s' from '%s' (%dx%d chars)",
@@ -480,6 +584,7 @@ void ResourceManager::unloadPixelFont(const std::string& name) {
     if (it != pixelFonts_.end()) {
         LOG_DEBUG_FMT("Unloading pixel font '%s'", name.c_str());
         pixelFonts_.erase(it);
+        untrackMemory(ResourceCategory::PixelFont, name);
     }
 }
 
@@ -488,26 +593,31 @@ void ResourceManager::unloadPixelFont(const std::string& name) {
 void ResourceManager::clearTextures() {
     LOG_DEBUG_FMT("Clearing %zu textures", textures_.size());
     textures_.clear();
+    clearMemory(ResourceCategory::Texture);
 }
 
 void ResourceManager::clearFonts() {
     LOG_DEBUG_FMT("Clearing %zu fonts", fonts_.size());
     fonts_.clear();
+    clearMemory(ResourceCategory::Font);
 }
 
 void ResourceManager::clearTilemaps() {
     LOG_DEBUG_FMT("Clearing %zu tilemaps", tilemaps_.size());
     tilemaps_.clear();
+    clearMemory(ResourceCategory::Tilemap);
 }
 
 void ResourceManager::clearPalettes() {
     LOG_DEBUG_FMT("Clearing %zu palettes", palettes_.size());
     palettes_.clear();
+    clearMemory(ResourceCategory::Palette);
 }
 
 void ResourceManager::clearPixelFonts() {
     LOG_DEBUG_FMT("Clearing %zu pixel fonts", pixelFonts_.size());
     pixelFonts_.clear();
+    clearMemory(ResourceCategory::PixelFont);
 }
 
 // ============================================================================
@@ -631,6 +741,10 @@ Mesh3DPtr ResourceManager::loadMesh3D(const std::string& name, const std::string
     LOG_INFO_FMT("Loaded Mesh3D '%s': %zu vertices, %zu normals, %zu polygons",
                  name.c_str(), vertices.size(), normals.size(), mesh->getPolygons().size());
 
+    if (!trackMemory(ResourceCategory::Mesh, name, measureMesh(*mesh))) {
+        return nullptr;
+    }
+
     meshes_[name] = mesh;
     return mesh;
 }
@@ -653,12 +767,14 @@ void ResourceManager::unloadMesh3D(const std::string& name) {
     if (it != meshes_.end()) {
         LOG_DEBUG_FMT("Unloading Mesh3D '%s'", name.c_str());
         meshes_.erase(it);
+        untrackMemory(ResourceCategory::Mesh, name);
     }
 }
 
 void ResourceManager::clearMeshes() {
     LOG_DEBUG_FMT("Clearing %zu meshes", meshes_.size());
     meshes_.clear();
+    clearMemory(ResourceCategory::Mesh);
 }
 
 void ResourceManager::clearAll() {
@@ -670,4 +786,123 @@ void ResourceManager::clearAll() {
     clearMeshes();
 }
 
+// ============================================================================
+// Memory Accounting
+// ============================================================================
+
+bool ResourceManager::trackMemory(ResourceCategory category, const std::string& name,
+                                  const ResourceMemory& memory) {
+    size_t index = static_cast<size_t>(category);
+    auto& entries = resourceMemory_[index];
+
+    // A replaced entry no longer counts against the budget
+    ResourceMemory previous;
+    auto it = entries.find(name);
+    if (it != entries.end()) {
+        previous = it->second;
+    }
+
+    ResourceMemory total = getTotalMemory();
+    size_t cpuAfter = total.cpuBytes - previous.cpuBytes + memory.cpuBytes;
+    size_t gpuAfter = total.gpuBytes - previous.gpuBytes + memory.gpuBytes;
+    bool cpuOver = budget_.cpuBytes > 0 && cpuAfter > budget_.cpuBytes;
+    bool gpuOver = budget_.gpuBytes > 0 && gpuAfter > budget_.gpuBytes;
+
+    if (cpuOver || gpuOver) {
+        if (budget_.action == BudgetAction::Fail) {
+            LOG_ERROR_FMT("Rejected %s '%s' (%zu CPU / %zu GPU bytes): memory budget exceeded "
+                          "(CPU %zu/%zu, GPU %zu/%zu)",
+                          toString(category), name.c_str(), memory.cpuBytes, memory.gpuBytes,
+                          cpuAfter, budget_.cpuBytes, gpuAfter, budget_.gpuBytes);
+            return false;
+        }
+        LOG_WARNING_FMT("%s '%s' (%zu CPU / %zu GPU bytes) exceeds memory budget "
+                        "(CPU %zu/%zu, GPU %zu/%zu)",
+                        toString(category), name.c_str(), memory.cpuBytes, memory.gpuBytes,
+                        cpuAfter, budget_.cpuBytes, gpuAfter, budget_.gpuBytes);
+    }
+
+    ResourceMemory& categoryTotal = categoryMemory_[index];
+    categoryTotal.cpuBytes = categoryTotal.cpuBytes - previous.cpuBytes + memory.cpuBytes;
+    categoryTotal.gpuBytes = categoryTotal.gpuBytes - previous.gpuBytes + memory.gpuBytes;
+    entries[name] = memory;
+    return true;
+}
+
+void ResourceManager::untrackMemory(ResourceCategory category, const std::string& name) {
+    size_t index = static_cast<size_t>(category);
+    auto it = resourceMemory_[index].find(name);
+    if (it != resourceMemory_[index].end()) {
+        categoryMemory_[index].cpuBytes -= it->second.cpuBytes;
+        categoryMemory_[index].gpuBytes -= it->second.gpuBytes;
+        resourceMemory_[index].erase(it);
+    }
+}
+
+void ResourceManager::clearMemory(ResourceCategory category) {
+    size_t index = static_cast<size_t>(category);
+    resourceMemory_[index].clear();
+    categoryMemory_[index] = ResourceMemory{};
+}
+
+ResourceMemory ResourceManager::getResourceMemory(ResourceCategory category, const std::string& name) const {
+    const auto& entries = resourceMemory_[static_cast<size_t>(category)];
+    auto it = entries.find(name);
+    if (it != entries.end()) {
+        return it->second;
+    }
+    return ResourceMemory{};
+}
+
+ResourceMemory ResourceManager::getTotalMemory() const {
+    ResourceMemory total;
+    for (const auto& memory : categoryMemory_) {
+        total.cpuBytes += memory.cpuBytes;
+        total.gpuBytes += memory.gpuBytes;
+    }
+    return total;
+}
+
+std::vector<ResourceMemoryEntry> ResourceManager::getMemoryReport() const {
+    std::vector<ResourceMemoryEntry> report;
+    for (size_t i = 0; i < kCategoryCount; ++i) {
+        for (const auto& [name, memory] : resourceMemory_[i]) {
+            report.push_back({static_cast<ResourceCategory>(i), name, memory});
+        }
+    }
+
+    std::sort(report.begin(), report.end(),
+        [](const ResourceMemoryEntry& a, const ResourceMemoryEntry& b) {
+            return a.memory.total() > b.memory.total();
+        });
+    return report;
+}
+
+void ResourceManager::logMemoryReport(size_t maxEntries) const {
+    ResourceMemory total = getTotalMemory();
+    LOG_INFO_FMT("Resource memory: %zu CPU bytes, %zu GPU bytes (budget CPU %zu, GPU %zu; 0 = unlimited)",
+                 total.cpuBytes, total.gpuBytes, budget_.cpuBytes, budget_.gpuBytes);
+
+    for (size_t i = 0; i < kCategoryCount; ++i) {
+        const ResourceMemory& memory = categoryMemory_[i];
+        LOG_INFO_FMT("  %-10s %4zu cached, %10zu CPU, %10zu GPU",
+                     toString(static_cast<ResourceCategory>(i)), resourceMemory_[i].size(),
+                     memory.cpuBytes, memory.gpuBytes);
+    }
+
+    auto report = getMemoryReport();
+    size_t count = std::min(maxEntries, report.size());
+    for (size_t i = 0; i < count; ++i) {
+        const auto& entry = report[i];
+        LOG_INFO_FMT("  #%zu %s '%s': %zu CPU, %zu GPU", i + 1, toString(entry.category),
+                     entry.name.c_str(), entry.memory.cpuBytes, entry.memory.gpuBytes);
+    }
+}
+
+bool ResourceManager::isOverBudget() const {
+    ResourceMemory total = getTotalMemory();
+    return (budget_.cpuBytes > 0 && total.cpuBytes > budget_.cpuBytes) ||
+           (budget_.gpuBytes > 0 && total.gpuBytes > budget_.gpuBytes);
+}
+
 } // namespace Engine
@@ -4,13 +4,30 @@
 #include "engine/Text.h"
 #include "engine/PixelBuffer.h"
 #include "engine/IndexedPixelBuffer.h"
+#include "engine/Profiler.h"
 #include <SDL_image.h>
 #include <SDL_ttf.h>
 #include <iostream>
 #include <cmath>
+#include <cstring>
 
 namespace Engine {
 
+namespace {
+    // Copy tightly packed colors into a locked texture with the given row pitch
+    void copyRows(void* dest, int pitch, const Color* src, int width, int height) {
+        size_t rowBytes = static_cast<size_t>(width) * sizeof(Color);
+        if (static_cast<size_t>(pitch) == rowBytes) {
+            std::memcpy(dest, src, rowBytes * height);
+            return;
+        }
+        for (int row = 0; row < height; ++row) {
+            std::memcpy(static_cast<uint8_t*>(dest) + static_cast<size_t>(row) * pitch,
+                        src + static_cast<size_t>(row) * width, rowBytes);
+        }
+    }
+}
+
 SDLRenderer::~SDLRenderer() {
     shutdown();
 }
@@ -90,15 +107,36 @@ void SDLRenderer::shutdown() {
 }
 
 void SDLRenderer::clear() {
+    PROFILE_ZONE("SDLRenderer::clear");
     SDL_SetRenderDrawColor(renderer_, 0, 0, 0, 255);
     SDL_RenderClear(renderer_);
+    beginFrameStats();
 }
 
 void SDLRenderer::present() {
+    PROFILE_ZONE("SDLRenderer::present");
     SDL_RenderPresent(renderer_);
+    endFrameStats();
+}
+
+bool SDLRenderer::setVSync(bool enabled) {
+    // Requires SDL 2.0.18+
+    return renderer_ && SDL_RenderSetVSync(renderer_, enabled ? 1 : 0) == 0;
+}
+
+bool SDLRenderer::readPixels(std::vector<Color>& pixels) {
+    if (!renderer_) {
+        return false;
+    }
+
+    // RGBA32 is byte order r, g, b, a on every platform - same layout as Color
+    pixels.resize(static_cast<size_t>(windowWidth_) * windowHeight_);
+    return SDL_RenderReadPixels(renderer_, nullptr, SDL_PIXELFORMAT_RGBA32,
+                                pixels.data(), windowWidth_ * static_cast<int>(sizeof(Color))) == 0;
 }
 
 void SDLRenderer::renderSprite(const Sprite& sprite, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("SDLRenderer::renderSprite");
     if (!sprite.isVisible() || !sprite.getTexture() || !sprite.getTexture()->isValid()) {
         return;
     }
@@ -135,6 +173,7 @@ void SDLRenderer::renderSprite(const Sprite& sprite, const Vec2& layerOffset, fl
 
     // Render with rotation
     SDL_Point center = {dstWidth / 2, dstHeight / 2};
+    countCopy(texture->getHandle());
     SDL_RenderCopyEx(
         renderer_,
         static_cast<SDL_Texture*>(texture->getHandle()),
@@ -147,6 +186,7 @@ void SDLRenderer::renderSprite(const Sprite& sprite, const Vec2& layerOffset, fl
 }
 
 void SDLRenderer::renderTilemap(const Tilemap& tilemap, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("SDLRenderer::renderTilemap");
     if (!tilemap.isVisible() || !tilemap.getTileset() || !tilemap.getTileset()->isValid()) {
         return;
     }
@@ -177,12 +217,14 @@ void SDLRenderer::renderTilemap(const Tilemap& tilemap, const Vec2& layerOffset,
                 tileHeight
             };
 
+            countCopy(tileset->getHandle());
             SDL_RenderCopy(renderer_, static_cast<SDL_Texture*>(tileset->getHandle()), &srcRect, &dstRect);
         }
     }
 }
 
 void SDLRenderer::renderText(const Text& text, const Vec2& position, float opacity) {
+    PROFILE_ZONE("SDLRenderer::renderText");
     if (!text.isValid()) {
         return;
     }
@@ -194,10 +236,12 @@ void SDLRenderer::renderText(const Text& text, const Vec2& position, float opaci
         text.getHeight()
     };
 
+    countCopy(text.getTexture());
     SDL_RenderCopy(renderer_, text.getTexture(), nullptr, &dstRect);
 }
 
 void SDLRenderer::renderPixelBuffer(const PixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("SDLRenderer::renderPixelBuffer");
     if (!buffer.isVisible() || !buffer.getTexture()) {
         return;
     }
@@ -218,6 +262,7 @@ void SDLRenderer::renderPixelBuffer(const PixelBuffer& buffer, const Vec2& layer
     };
 
     // Render the pixel buffer texture
+    countCopy(buffer.getTexture()->getHandle());
     SDL_RenderCopy(renderer_, static_cast<SDL_Texture*>(buffer.getTexture()->getHandle()), nullptr, &dstRect);
 }
 
@@ -246,6 +291,7 @@ TexturePtr SDLRenderer::createStreamingTexture(int width, int height) {
 }
 
 void SDLRenderer::updateTexture(Texture& texture, const Color* pixels, int width, int height) {
+    PROFILE_ZONE("SDLRenderer::updateTexture");
     SDL_Texture* sdlTexture = static_cast<SDL_Texture*>(texture.getHandle());
     if (!sdlTexture) {
         return;
@@ -258,19 +304,39 @@ void SDLRenderer::updateTexture(Texture& texture, const Color* pixels, int width
         return;
     }
 
-    // Copy pixel data (convert from Color to RGBA32)
-    Uint32* dest = static_cast<Uint32*>(texturePixels);
-    for (int i = 0; i < width * height; ++i) {
-        const Color& c = pixels[i];
-        // RGBA32 format: 0xRRGGBBAA
-        dest[i] = (c.r << 24) | (c.g << 16) | (c.b << 8) | c.a;
-    }
+    // Copy pixel data - Color is byte-ordered R,G,B,A, exactly SDL_PIXELFORMAT_RGBA32
+    copyRows(texturePixels, pitch, pixels, width, height);
 
     // Unlock texture
     SDL_UnlockTexture(sdlTexture);
+    countUpload(static_cast<uint64_t>(width) * height * sizeof(Color));
+}
+
+bool SDLRenderer::updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) {
+    PROFILE_ZONE("SDLRenderer::updateTextureRegion");
+    SDL_Texture* sdlTexture = static_cast<SDL_Texture*>(texture.getHandle());
+    if (!sdlTexture) {
+        return false;
+    }
+
+    // Lock only the changed rectangle
+    SDL_Rect rect = {x, y, width, height};
+    void* texturePixels;
+    int pitch;
+    if (SDL_LockTexture(sdlTexture, &rect, &texturePixels, &pitch) != 0) {
+        return false;
+    }
+
+    // Copy row by row - the locked region keeps the full texture pitch
+    copyRows(texturePixels, pitch, pixels, width, height);
+
+    SDL_UnlockTexture(sdlTexture);
+    countUpload(static_cast<uint64_t>(width) * height * sizeof(Color));
+    return true;
 }
 
 void SDLRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("SDLRenderer::renderIndexedPixelBuffer");
     if (!buffer.isVisible() || !buffer.getTexture()) {
         return;
     }
@@ -291,6 +357,7 @@ void SDLRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, con
     };
 
     // Render the indexed pixel buffer texture
+    countCopy(buffer.getTexture()->getHandle());
     SDL_RenderCopy(renderer_, static_cast<SDL_Texture*>(buffer.getTexture()->getHandle()), nullptr, &dstRect);
 }
 
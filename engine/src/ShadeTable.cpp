@@ -0,0 +1,60 @@
+#include "engine/ShadeTable.h"
+#include "engine/Palette.h"
+#include "engine/PixelKernels.h"
+#include "engine/Profiler.h"
+#include "engine/WorkerPool.h"
+#include <algorithm>
+#include <cstring>
+
+namespace Engine {
+
+std::shared_ptr<const ShadeTable> ShadeTable::create(const Palette& palette, int levelCount, const Color& fog) {
+    PROFILE_ZONE("ShadeTable::create");
+
+    levelCount = std::max(2, std::min(levelCount, kMaxLevels));
+    std::shared_ptr<ShadeTable> table(new ShadeTable());
+    table->levelCount_ = levelCount;
+    table->levels_.resize(static_cast<size_t>(levelCount) * 256);
+
+    std::shared_ptr<const Palette::InverseTable> inverse = palette.getInverseTable();
+    const Color* colors = palette.getColors().data();
+    int top = levelCount - 1;
+    // One task per level; each fills its own 256-byte row
+    WorkerPool::getInstance().parallelFor(levelCount, [&](int level) {
+        uint8_t* row = &table->levels_[static_cast<size_t>(level) << 8];
+        if (level == top) {
+            for (int i = 0; i < 256; ++i) {
+                row[i] = static_cast<uint8_t>(i);  // Full brightness is the identity
+            }
+            return;
+        }
+        auto fade = [&](int from, int to) {
+            return static_cast<uint8_t>((to * level + from * (top - level) + top / 2) / top);
+        };
+        for (int i = 0; i < 256; ++i) {
+            const Color& c = colors[i];
+            Color shaded{fade(fog.r, c.r), fade(fog.g, c.g), fade(fog.b, c.b), c.a};
+            row[i] = inverse->findNearest(shaded, colors);
+        }
+    });
+
+    // Light values index the levels directly
+    table->byLight_.resize(256 * 256 + kShadeTablePadding, 0);
+    for (int light = 0; light < 256; ++light) {
+        int level = (light * top + 127) / 255;
+        std::memcpy(&table->byLight_[static_cast<size_t>(light) << 8],
+                    &table->levels_[static_cast<size_t>(level) << 8], 256);
+    }
+    return table;
+}
+
+uint8_t ShadeTable::shade(uint8_t index, int level) const {
+    return getLevel(level)[index];
+}
+
+const uint8_t* ShadeTable::getLevel(int level) const {
+    level = std::max(0, std::min(level, levelCount_ - 1));
+    return &levels_[static_cast<size_t>(level) << 8];
+}
+
+} // namespace Engine
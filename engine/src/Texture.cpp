@@ -62,6 +62,11 @@ bool Texture::loadFromFile(const std::string& path, IRenderer& renderer) {
         backendHandle_ = nullptr;
     }
 
+    // Each backend decides where the decoded image lives
+    return renderer.loadTextureFromFile(*this, path);
+}
+
+bool IRenderer::loadTextureFromFile(Texture& texture, const std::string& path) {
     // Load image using SDL_Image (this is backend-agnostic image loading)
     SDL_Surface* surface = IMG_Load(path.c_str());
     if (!surface) {
@@ -70,9 +75,8 @@ bool Texture::loadFromFile(const std::string& path, IRenderer& renderer) {
     }
 
     // Create texture using backend context (SDL_Renderer* for SDL backend)
-    // NOTE: This assumes SDL backend for now. For true backend independence,
-    // this method should be moved to IRenderer as loadTextureFromFile()
-    SDL_Renderer* sdlRenderer = static_cast<SDL_Renderer*>(renderer.getBackendContext());
+    // NOTE: Backends without an SDL_Renderer context must override this
+    SDL_Renderer* sdlRenderer = static_cast<SDL_Renderer*>(getBackendContext());
     SDL_Texture* sdlTexture = SDL_CreateTextureFromSurface(sdlRenderer, surface);
     if (!sdlTexture) {
         std::cerr << "Failed to create texture from " << path << ": " << SDL_GetError() << std::endl;
@@ -80,15 +84,13 @@ bool Texture::loadFromFile(const std::string& path, IRenderer& renderer) {
         return false;
     }
 
-    width_ = surface->w;
-    height_ = surface->h;
+    texture.setDimensions(surface->w, surface->h);
     SDL_FreeSurface(surface);
 
     // Set the backend handle with SDL-specific deleter
-    backendHandle_ = sdlTexture;
-    deleter_ = [](void* handle) {
+    texture.setHandle(sdlTexture, [](void* handle) {
         SDL_DestroyTexture(static_cast<SDL_Texture*>(handle));
-    };
+    });
 
     return true;
 }
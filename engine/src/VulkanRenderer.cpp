@@ -5,6 +5,7 @@
 #include "engine/PixelBuffer.h"
 #include "engine/IndexedPixelBuffer.h"
 #include "engine/Logger.h"
+#include "engine/Profiler.h"
 #include <iostream>
 #include <fstream>
 #include <set>
@@ -234,9 +235,11 @@ void VulkanRenderer::shutdown() {
 
 void VulkanRenderer::clear() {
     // Clear will be handled in the render pass
+    beginFrameStats();
 }
 
 bool VulkanRenderer::beginFrame() {
+    PROFILE_ZONE("VulkanRenderer::beginFrame");
     // Already in a frame, don't begin again
     if (frameInProgress_) {
         return true;
@@ -292,6 +295,7 @@ bool VulkanRenderer::beginFrame() {
 
     // Bind graphics pipeline
     vkCmdBindPipeline(currentCommandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS, graphicsPipeline_);
+    ++frameStats_.pipelineSwitches;
 
     // Bind vertex and index buffers
     VkBuffer vertexBuffers[] = {quadVertexBuffer_};
@@ -303,6 +307,7 @@ bool VulkanRenderer::beginFrame() {
     vkCmdBindDescriptorSets(currentCommandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS,
                            pipelineLayout_, 0, 1, &uniformDescriptorSets_[currentFrame_],
                            0, nullptr);
+    ++frameStats_.descriptorBinds;
 
     frameInProgress_ = true;
     return true;
@@ -350,12 +355,14 @@ void VulkanRenderer::endFrame() {
 }
 
 void VulkanRenderer::present() {
+    PROFILE_ZONE("VulkanRenderer::present");
     // If no frame was started, there's nothing to present
     // This can happen when clear() is called but no renderables draw anything
     bool hadFrame = frameInProgress_;
 
     // End the frame (submit command buffer) if one is in progress
     endFrame();
+    endFrameStats();
 
     // Only present if we actually had a frame to render
     if (!hadFrame) {
@@ -389,6 +396,7 @@ void VulkanRenderer::present() {
 
 // Rendering implementations
 void VulkanRenderer::renderSprite(const Sprite& sprite, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("VulkanRenderer::renderSprite");
     // Skip invisible sprites
     if (!sprite.isVisible()) {
         return;
@@ -456,12 +464,15 @@ void VulkanRenderer::renderSprite(const Sprite& sprite, const Vec2& layerOffset,
     vkCmdBindDescriptorSets(currentCommandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS,
                            pipelineLayout_, 1, 1, &vkTexture->descriptorSet,
                            0, nullptr);
+    countTextureDescriptor(vkTexture);
 
     // Draw the quad (6 indices = 2 triangles)
     vkCmdDrawIndexed(currentCommandBuffer_, 6, 1, 0, 0, 0);
+    countQuadDraw();
 }
 
 void VulkanRenderer::renderTilemap(const Tilemap& tilemap, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("VulkanRenderer::renderTilemap");
     if (!tilemap.isVisible() || !tilemap.getTileset() || !tilemap.getTileset()->isValid()) {
         return;
     }
@@ -489,6 +500,7 @@ void VulkanRenderer::renderTilemap(const Tilemap& tilemap, const Vec2& layerOffs
     vkCmdBindDescriptorSets(currentCommandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS,
                            pipelineLayout_, 1, 1, &vkTexture->descriptorSet,
                            0, nullptr);
+    countTextureDescriptor(vkTexture);
 
     // Render each tile
     for (int y = 0; y < tilemap.getHeight(); ++y) {
@@ -519,6 +531,7 @@ void VulkanRenderer::renderTilemap(const Tilemap& tilemap, const Vec2& layerOffs
 
             // Draw the tile
             vkCmdDrawIndexed(currentCommandBuffer_, 6, 1, 0, 0, 0);
+            countQuadDraw();
         }
     }
 }
@@ -539,6 +552,7 @@ void VulkanRenderer::renderText(const Text& text, const Vec2& position, float op
 }
 
 void VulkanRenderer::renderPixelBuffer(const PixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("VulkanRenderer::renderPixelBuffer");
     if (!buffer.isVisible() || !buffer.getTexture()) {
         return;
     }
@@ -582,12 +596,15 @@ void VulkanRenderer::renderPixelBuffer(const PixelBuffer& buffer, const Vec2& la
     vkCmdBindDescriptorSets(currentCommandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS,
                            pipelineLayout_, 1, 1, &vkTexture->descriptorSet,
                            0, nullptr);
+    countTextureDescriptor(vkTexture);
 
     // Draw the quad
     vkCmdDrawIndexed(currentCommandBuffer_, 6, 1, 0, 0, 0);
+    countQuadDraw();
 }
 
 void VulkanRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer, const Vec2& layerOffset, float opacity) {
+    PROFILE_ZONE("VulkanRenderer::renderIndexedPixelBuffer");
     if (!buffer.isVisible()) {
         return;
     }
@@ -637,9 +654,11 @@ void VulkanRenderer::renderIndexedPixelBuffer(const IndexedPixelBuffer& buffer,
     vkCmdBindDescriptorSets(currentCommandBuffer_, VK_PIPELINE_BIND_POINT_GRAPHICS,
                            pipelineLayout_, 1, 1, &vkTexture->descriptorSet,
                            0, nullptr);
+    countTextureDescriptor(vkTexture);
 
     // Draw the quad
     vkCmdDrawIndexed(currentCommandBuffer_, 6, 1, 0, 0, 0);
+    countQuadDraw();
 }
 
 TexturePtr VulkanRenderer::createStreamingTexture(int width, int height) {
@@ -672,6 +691,7 @@ TexturePtr VulkanRenderer::createStreamingTexture(int width, int height) {
 }
 
 void VulkanRenderer::updateTexture(Texture& texture, const Color* pixels, int width, int height) {
+    PROFILE_ZONE("VulkanRenderer::updateTexture");
     if (!texture.isValid() || !pixels) {
         return;
     }
@@ -721,6 +741,7 @@ void VulkanRenderer::updateTexture(Texture& texture, const Color* pixels, int wi
         // Clean up staging buffer
         vkDestroyBuffer(device_, stagingBuffer, nullptr);
         vkFreeMemory(device_, stagingBufferMemory, nullptr);
+        countUpload(imageSize);
         return;
     }
 
@@ -734,7 +755,54 @@ void VulkanRenderer::updateTexture(Texture& texture, const Color* pixels, int wi
     // Create new texture from pixels
     if (!createTextureFromPixels(pixels, width, height, vkTexture)) {
         LOG_ERROR("Failed to create/update Vulkan texture from pixels");
+        return;
+    }
+    countUpload(static_cast<uint64_t>(width) * height * sizeof(Color));
+}
+
+bool VulkanRenderer::updateTextureRegion(Texture& texture, const Color* pixels, int x, int y, int width, int height) {
+    PROFILE_ZONE("VulkanRenderer::updateTextureRegion");
+    if (!texture.isValid() || !pixels || width <= 0 || height <= 0) {
+        return false;
+    }
+
+    auto it = textureCache_.find(texture.getHandle());
+    if (it == textureCache_.end() || it->second.image == VK_NULL_HANDLE) {
+        return false;  // No image yet - caller creates it with a full update
     }
+
+    VulkanTexture& vkTexture = it->second;
+    if (x < 0 || y < 0 || x + width > vkTexture.width || y + height > vkTexture.height) {
+        return false;
+    }
+
+    // Stage only the changed rectangle (tightly packed)
+    VkDeviceSize regionSize = static_cast<VkDeviceSize>(width) * height * 4;
+    VkBuffer stagingBuffer;
+    VkDeviceMemory stagingBufferMemory;
+    if (!createBuffer(regionSize, VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                     VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                     stagingBuffer, stagingBufferMemory)) {
+        LOG_ERROR("Failed to create staging buffer for texture region update");
+        return false;
+    }
+
+    void* data;
+    vkMapMemory(device_, stagingBufferMemory, 0, regionSize, 0, &data);
+    memcpy(data, pixels, static_cast<size_t>(regionSize));
+    vkUnmapMemory(device_, stagingBufferMemory);
+
+    transitionImageLayout(vkTexture.image, VK_FORMAT_R8G8B8A8_UNORM,
+                         VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL);
+    copyBufferToImage(stagingBuffer, vkTexture.image, static_cast<uint32_t>(width), static_cast<uint32_t>(height),
+                      x, y);
+    transitionImageLayout(vkTexture.image, VK_FORMAT_R8G8B8A8_UNORM,
+                         VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, VK_IMAGE_LAYOUT_SHADER_READ_ONLY_OPTIMAL);
+
+    vkDestroyBuffer(device_, stagingBuffer, nullptr);
+    vkFreeMemory(device_, stagingBufferMemory, nullptr);
+    countUpload(regionSize);
+    return true;
 }
 
 // Implementation of initialization helpers
@@ -1789,7 +1857,8 @@ void VulkanRenderer::transitionImageLayout(VkImage image, VkFormat format,
     vkFreeCommandBuffers(device_, commandPool_, 1, &commandBuffer);
 }
 
-void VulkanRenderer::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height) {
+void VulkanRenderer::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t width, uint32_t height,
+                                       int32_t offsetX, int32_t offsetY) {
     VkCommandBufferAllocateInfo allocInfo{};
     allocInfo.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_ALLOCATE_INFO;
     allocInfo.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY;
@@ -1813,7 +1882,7 @@ void VulkanRenderer::copyBufferToImage(VkBuffer buffer, VkImage image, uint32_t
     region.imageSubresource.mipLevel = 0;
     region.imageSubresource.baseArrayLayer = 0;
     region.imageSubresource.layerCount = 1;
-    region.imageOffset = {0, 0, 0};
+    region.imageOffset = {offsetX, offsetY, 0};
     region.imageExtent = {width, height, 1};
 
     vkCmdCopyBufferToImage(commandBuffer, buffer, image, VK_IMAGE_LAYOUT_TRANSFER_DST_OPTIMAL, 1, &region);
@@ -0,0 +1,176 @@
+#include "engine/WorkerPool.h"
+#include "engine/Logger.h"
+#include "engine/Profiler.h"
+#include <algorithm>
+#include <string>
+
+namespace Engine {
+
+namespace {
+
+int hardwareThreadCount() {
+    return static_cast<int>(std::max(1u, std::thread::hardware_concurrency()));
+}
+
+// Set on pool threads so nested run() calls execute inline instead of deadlocking
+thread_local bool tlsIsWorker = false;
+
+} // anonymous namespace
+
+WorkerPool::~WorkerPool() {
+    stopWorkers();
+}
+
+void WorkerPool::setThreadCount(int count) {
+    std::lock_guard<std::mutex> dispatch(dispatchMutex_);
+    if (count <= 0) {
+        count = hardwareThreadCount();
+    }
+    if (count == threadCount_.load(std::memory_order_relaxed)) {
+        return;
+    }
+    stopWorkers();
+    startWorkers(count);
+}
+
+int WorkerPool::getThreadCount() const {
+    int count = threadCount_.load(std::memory_order_relaxed);
+    return count > 0 ? count : hardwareThreadCount();
+}
+
+void WorkerPool::startWorkers(int threadCount) {
+    // No job is in flight (dispatchMutex_ is held), so the new workers start
+    // out having seen the current generation
+    stopRequested_ = false;
+    workers_.reserve(static_cast<size_t>(threadCount - 1));
+    for (int i = 0; i + 1 < threadCount; ++i) {
+        workers_.emplace_back(&WorkerPool::workerLoop, this, i, generation_);
+    }
+    threadCount_.store(threadCount, std::memory_order_relaxed);
+    LOG_DEBUG_FMT("WorkerPool started with %d threads", threadCount);
+}
+
+void WorkerPool::stopWorkers() {
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        stopRequested_ = true;
+    }
+    wakeCondition_.notify_all();
+    for (auto& worker : workers_) {
+        worker.join();
+    }
+    workers_.clear();
+    threadCount_.store(0, std::memory_order_relaxed);
+}
+
+void WorkerPool::workerLoop(int workerIndex, uint64_t startGeneration) {
+    tlsIsWorker = true;
+    if (Profiler::getInstance().isEnabled()) {
+        Profiler::getInstance().setThreadName("Worker " + std::to_string(workerIndex + 1));
+    }
+
+    uint64_t seenGeneration = startGeneration;
+    for (;;) {
+        {
+            std::unique_lock<std::mutex> lock(stateMutex_);
+            wakeCondition_.wait(lock, [&] { return stopRequested_ || generation_ != seenGeneration; });
+            if (stopRequested_) {
+                return;
+            }
+            seenGeneration = generation_;
+        }
+
+        drainTasks();
+
+        // The dispatcher waits for every worker, so the job stays valid until this point
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        if (--pendingWorkers_ == 0) {
+            doneCondition_.notify_one();
+        }
+    }
+}
+
+void WorkerPool::drainTasks() {
+    for (;;) {
+        int index = nextTask_.fetch_add(1, std::memory_order_relaxed);
+        if (index >= taskCount_) {
+            return;
+        }
+        task_(context_, index);
+    }
+}
+
+void WorkerPool::run(int count, TaskFn task, void* context) {
+    if (count <= 0) {
+        return;
+    }
+
+    // Serial paths: single task, nested call, or another thread already dispatching
+    std::unique_lock<std::mutex> dispatch(dispatchMutex_, std::defer_lock);
+    if (count == 1 || tlsIsWorker || !dispatch.try_lock()) {
+        for (int i = 0; i < count; ++i) {
+            task(context, i);
+        }
+        return;
+    }
+    if (threadCount_.load(std::memory_order_relaxed) == 0) {
+        startWorkers(hardwareThreadCount());
+    }
+    if (workers_.empty()) {
+        for (int i = 0; i < count; ++i) {
+            task(context, i);
+        }
+        return;
+    }
+
+    PROFILE_ZONE("WorkerPool::run");
+    {
+        std::lock_guard<std::mutex> lock(stateMutex_);
+        task_ = task;
+        context_ = context;
+        taskCount_ = count;
+        nextTask_.store(0, std::memory_order_relaxed);
+        pendingWorkers_ = static_cast<int>(workers_.size());
+        ++generation_;
+    }
+    wakeCondition_.notify_all();
+
+    // The caller works too, then waits for the workers to let go of the job
+    drainTasks();
+    std::unique_lock<std::mutex> lock(stateMutex_);
+    doneCondition_.wait(lock, [this] { return pendingWorkers_ == 0; });
+}
+
+void WorkerPool::runBands(int rowCount, size_t bytesPerRow, BandFn band, void* context) {
+    if (rowCount <= 0) {
+        return;
+    }
+
+    // Rows per band: about kTargetBandBytes each, but at least kBandsPerThread
+    // bands per thread when the job is big enough to split that finely
+    int threads = tlsIsWorker ? 1 : getThreadCount();
+    size_t rowBytes = std::max<size_t>(bytesPerRow, 1);
+    int bandRows = static_cast<int>(std::max<size_t>(1, kTargetBandBytes / rowBytes));
+    int balancedRows = (rowCount + threads * kBandsPerThread - 1) / (threads * kBandsPerThread);
+    bandRows = std::max(1, std::min(bandRows, balancedRows));
+    if (threads == 1) {
+        bandRows = rowCount;
+    }
+
+    struct BandJob {
+        BandFn band;
+        void* context;
+        int rowCount;
+        int bandRows;
+    } job{band, context, rowCount, bandRows};
+
+    int bandCount = (rowCount + bandRows - 1) / bandRows;
+    run(bandCount, [](void* jobContext, int index) {
+        const BandJob& bandJob = *static_cast<const BandJob*>(jobContext);
+        int begin = index * bandJob.bandRows;
+        int end = std::min(begin + bandJob.bandRows, bandJob.rowCount);
+        bandJob.band(bandJob.context, begin, end);
+    }, &job);
+}
+
+} // namespace Engine